@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace acmlib {
+namespace memory {
+
+// A bump allocator for short-lived scratch storage.
+//
+// Allocation advances a pointer inside a block obtained
+// from the upstream resource; deallocation does nothing,
+// memory is reclaimed all at once by rewinding to a marker,
+// see Scope. Blocks are kept for reuse, and once rewound
+// to the very beginning the arena merges them into one,
+// so a workload repeated in a loop stops allocating
+// from upstream after its first iteration.
+//
+// The arena is a std::pmr::memory_resource: pass it to
+// std::pmr containers, e.g. std::pmr::vector<LPoint> v(&arena).
+// It is not thread-safe; every thread has its own local().
+class Arena : public std::pmr::memory_resource {
+public:
+  // A position in the arena to rewind to.
+  struct Marker {
+    size_t block = 0;
+    size_t offset = 0;
+  };
+
+  // Rewinds the arena to the position it had on construction.
+  // Containers using the arena must be destroyed first.
+  class Scope {
+  public:
+    explicit Scope(Arena &arena = Arena::local())
+        : arena(arena), marker(arena.mark()) {}
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    ~Scope() { arena.rewind(marker); }
+
+  private:
+    Arena &arena;
+    Marker marker;
+  };
+
+  // The first block has the given size, later ones double.
+  explicit Arena(size_t initialSize = 1 << 16,
+                 std::pmr::memory_resource *upstream =
+                     std::pmr::new_delete_resource())
+      : initialSize(std::max<size_t>(initialSize, 64)), upstream(upstream) {}
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  ~Arena() { release(); }
+
+  // The arena of the calling thread.
+  static Arena &local() {
+    static thread_local Arena arena;
+    return arena;
+  }
+
+  // The current position.
+  Marker mark() const { return {current, used}; }
+
+  // Frees everything allocated since the marker was taken.
+  void rewind(Marker marker) {
+    current = marker.block;
+    used = marker.offset;
+    if (current == 0 && used == 0 && blocks.size() > 1) {
+      size_t total = capacity();
+      release();
+      addBlock(total);
+    }
+  }
+
+  // Frees everything.
+  void reset() { rewind({}); }
+
+  // Bytes in all blocks.
+  size_t capacity() const {
+    size_t total = 0;
+    for (const Block &block : blocks)
+      total += block.size;
+    return total;
+  }
+
+  // The number of blocks requested from upstream so far.
+  size_t upstreamAllocations() const { return allocations; }
+
+protected:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    while (current < blocks.size()) {
+      Block &block = blocks[current];
+      uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+      size_t start = (base + used + alignment - 1) / alignment * alignment -
+                     base;
+      if (start + bytes <= block.size) {
+        used = start + bytes;
+        return block.data + start;
+      }
+      if (current + 1 == blocks.size())
+        break;
+      ++current;
+      used = 0;
+    }
+    size_t size = blocks.empty() ? initialSize : 2 * blocks.back().size;
+    addBlock(std::max(size, bytes + alignment));
+    return do_allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *, size_t, size_t) override {}
+
+  bool do_is_equal(const std::pmr::memory_resource &other) const
+      noexcept override {
+    return this == &other;
+  }
+
+private:
+  struct Block {
+    char *data;
+    size_t size;
+  };
+
+  void addBlock(size_t size) {
+    blocks.push_back({static_cast<char *>(upstream->allocate(
+                          size, alignof(std::max_align_t))),
+                      size});
+    ++allocations;
+    current = blocks.size() - 1;
+    used = 0;
+  }
+
+  void release() {
+    for (const Block &block : blocks)
+      upstream->deallocate(block.data, block.size, alignof(std::max_align_t));
+    blocks.clear();
+    current = used = 0;
+  }
+
+  size_t initialSize;
+  std::pmr::memory_resource *upstream;
+  std::vector<Block> blocks;
+  size_t current = 0;
+  size_t used = 0;
+  size_t allocations = 0;
+};
+
+} // namespace memory
+} // namespace acmlib
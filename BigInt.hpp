@@ -0,0 +1,361 @@
+#pragma once
+
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+namespace acmlib {
+namespace numeric {
+
+// A signed integer of fixed width 64 * N bits,
+// stored on the stack in N limbs.
+//
+// Intended for exact predicates whose intermediate
+// values exceed 128 bits but are bounded in advance,
+// so N is chosen once per predicate.
+// No heap allocation ever happens.
+//
+// Arithmetic is two's complement modulo 2^(64N):
+// like built-in integers, overflow wraps silently.
+// addOverflow and mulOverflow detect it, as the
+// __builtin_*_overflow functions do for built-in integers.
+template <size_t N>
+class BigInt {
+  static_assert(N > 0);
+
+  // Little-endian limbs of the two's complement representation.
+  std::array<uint64_t, N> limbs;
+
+public:
+  // Default constructor: zero.
+  constexpr BigInt() : limbs{} {}
+
+  // Construct from a built-in integer.
+  template <typename I, typename = std::enable_if_t<
+                            std::is_integral<I>::value ||
+                            std::is_same<I, __int128>::value ||
+                            std::is_same<I, unsigned __int128>::value>>
+  constexpr BigInt(I x) : limbs{} {
+    constexpr bool isSigned =
+        std::is_signed<I>::value || std::is_same<I, __int128>::value;
+    uint64_t fill = isSigned && x < 0 ? ~uint64_t(0) : 0;
+    limbs[0] = static_cast<uint64_t>(x);
+    if constexpr (sizeof(I) > 8) {
+      if (N > 1)
+        limbs[1] = static_cast<uint64_t>(x >> 64);
+      for (size_t i = 2; i < N; ++i)
+        limbs[i] = fill;
+    } else {
+      for (size_t i = 1; i < N; ++i)
+        limbs[i] = fill;
+    }
+  }
+
+  // Conversion between widths: sign-extends or truncates.
+  template <size_t M>
+  constexpr explicit BigInt(BigInt<M> other) : limbs{} {
+    uint64_t fill = other.isNegative() ? ~uint64_t(0) : 0;
+    for (size_t i = 0; i < N; ++i)
+      limbs[i] = i < M ? other.limb(i) : fill;
+  }
+
+  // Access to the raw limbs.
+  constexpr uint64_t limb(size_t i) const { return limbs[i]; }
+
+  constexpr bool isNegative() const { return limbs[N - 1] >> 63; }
+  constexpr bool isZero() const {
+    for (size_t i = 0; i < N; ++i)
+      if (limbs[i])
+        return false;
+    return true;
+  }
+
+  // -1, 0 or +1, without materializing a comparison with zero.
+  constexpr int32_t sign() const {
+    if (isNegative())
+      return -1;
+    return isZero() ? 0 : 1;
+  }
+
+  // Explicit conversion to primitive types.
+  //
+  // Integer types receive the low bits,
+  // floating-point types the rounded value.
+  template <typename U>
+  constexpr explicit operator U() const {
+    if constexpr (std::is_floating_point<U>::value) {
+      BigInt magnitude = isNegative() ? -*this : *this;
+      U result = 0;
+      for (size_t i = N; i-- > 0;)
+        result = result * U(18446744073709551616.0l) + U(magnitude.limbs[i]);
+      return isNegative() ? -result : result;
+    } else if constexpr (sizeof(U) > 8) {
+      unsigned __int128 low = limbs[0];
+      if (N > 1)
+        low |= static_cast<unsigned __int128>(limbs[1]) << 64;
+      else if (isNegative())
+        low |= static_cast<unsigned __int128>(~uint64_t(0)) << 64;
+      return static_cast<U>(low);
+    } else {
+      return static_cast<U>(limbs[0]);
+    }
+  }
+
+  // Arithmetic operators.
+  constexpr BigInt &operator+=(BigInt other) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < N; ++i) {
+      unsigned __int128 sum =
+          static_cast<unsigned __int128>(limbs[i]) + other.limbs[i] + carry;
+      limbs[i] = static_cast<uint64_t>(sum);
+      carry = static_cast<uint64_t>(sum >> 64);
+    }
+    return *this;
+  }
+  constexpr BigInt &operator-=(BigInt other) {
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < N; ++i) {
+      unsigned __int128 difference =
+          static_cast<unsigned __int128>(limbs[i]) - other.limbs[i] - borrow;
+      limbs[i] = static_cast<uint64_t>(difference);
+      borrow = static_cast<uint64_t>(difference >> 64) & 1;
+    }
+    return *this;
+  }
+  // Schoolbook product truncated to N limbs;
+  // in two's complement it is correct for signed operands too.
+  constexpr BigInt &operator*=(BigInt other) {
+    std::array<uint64_t, N> result{};
+    for (size_t i = 0; i < N; ++i) {
+      if (!limbs[i])
+        continue;
+      uint64_t carry = 0;
+      for (size_t j = 0; i + j < N; ++j) {
+        unsigned __int128 product =
+            static_cast<unsigned __int128>(limbs[i]) * other.limbs[j] +
+            result[i + j] + carry;
+        result[i + j] = static_cast<uint64_t>(product);
+        carry = static_cast<uint64_t>(product >> 64);
+      }
+    }
+    limbs = result;
+    return *this;
+  }
+  // Division truncates towards zero, as for built-in integers.
+  // The divisor must be non-zero.
+  constexpr BigInt &operator/=(BigInt other) {
+    BigInt remainder;
+    divide(*this, other, *this, remainder);
+    return *this;
+  }
+  // The remainder has the sign of the dividend.
+  constexpr BigInt &operator%=(BigInt other) {
+    BigInt quotient;
+    divide(*this, other, quotient, *this);
+    return *this;
+  }
+  constexpr friend BigInt operator+(BigInt lhs, BigInt rhs) {
+    return lhs += rhs;
+  }
+  constexpr friend BigInt operator-(BigInt lhs, BigInt rhs) {
+    return lhs -= rhs;
+  }
+  constexpr friend BigInt operator*(BigInt lhs, BigInt rhs) {
+    return lhs *= rhs;
+  }
+  constexpr friend BigInt operator/(BigInt lhs, BigInt rhs) {
+    return lhs /= rhs;
+  }
+  constexpr friend BigInt operator%(BigInt lhs, BigInt rhs) {
+    return lhs %= rhs;
+  }
+  // Checked arithmetic: stores the wrapped result
+  // and returns true iff it overflowed.
+  static constexpr bool addOverflow(BigInt a, BigInt b, BigInt &result) {
+    bool sameSigns = a.isNegative() == b.isNegative();
+    result = a + b;
+    return sameSigns && result.isNegative() != a.isNegative();
+  }
+  static constexpr bool mulOverflow(BigInt a, BigInt b, BigInt &result) {
+    bool negative = a.isNegative() != b.isNegative();
+    BigInt x = a.isNegative() ? -a : a, y = b.isNegative() ? -b : b;
+    // Magnitudes as unsigned numbers, the full product
+    // must fit in 64N - 1 bits, or be 2^(64N - 1) if negative.
+    bool overflow = false;
+    std::array<uint64_t, N> low{};
+    for (size_t i = 0; i < N; ++i) {
+      if (!x.limbs[i])
+        continue;
+      uint64_t carry = 0;
+      for (size_t j = 0; j < N; ++j) {
+        if (i + j >= N) {
+          overflow |= y.limbs[j] != 0;
+          continue;
+        }
+        unsigned __int128 product =
+            static_cast<unsigned __int128>(x.limbs[i]) * y.limbs[j] +
+            low[i + j] + carry;
+        low[i + j] = static_cast<uint64_t>(product);
+        carry = static_cast<uint64_t>(product >> 64);
+      }
+      overflow |= carry != 0;
+    }
+    BigInt magnitude;
+    magnitude.limbs = low;
+    result = negative ? -magnitude : magnitude;
+    if (magnitude.isNegative())
+      overflow |= !negative || magnitude != -magnitude;
+    return overflow;
+  }
+
+  constexpr BigInt operator+() const { return *this; }
+  constexpr BigInt operator-() const {
+    BigInt result;
+    for (size_t i = 0; i < N; ++i)
+      result.limbs[i] = ~limbs[i];
+    return result += 1;
+  }
+  constexpr BigInt &operator++() { return *this += 1; }
+  constexpr BigInt operator++(int32_t) {
+    BigInt copy = *this;
+    *this += 1;
+    return copy;
+  }
+  constexpr BigInt &operator--() { return *this -= 1; }
+  constexpr BigInt operator--(int32_t) {
+    BigInt copy = *this;
+    *this -= 1;
+    return copy;
+  }
+
+  // Comparison operators.
+  constexpr friend bool operator==(BigInt lhs, BigInt rhs) {
+    for (size_t i = 0; i < N; ++i)
+      if (lhs.limbs[i] != rhs.limbs[i])
+        return false;
+    return true;
+  }
+  constexpr friend bool operator!=(BigInt lhs, BigInt rhs) {
+    return !(lhs == rhs);
+  }
+  constexpr friend bool operator<(BigInt lhs, BigInt rhs) {
+    if (lhs.isNegative() != rhs.isNegative())
+      return lhs.isNegative();
+    return lhs.lessUnsigned(rhs);
+  }
+  constexpr friend bool operator>(BigInt lhs, BigInt rhs) { return rhs < lhs; }
+  constexpr friend bool operator<=(BigInt lhs, BigInt rhs) {
+    return !(rhs < lhs);
+  }
+  constexpr friend bool operator>=(BigInt lhs, BigInt rhs) {
+    return !(lhs < rhs);
+  }
+
+  // I/O stream operators, in decimal.
+  friend std::istream &operator>>(std::istream &is, BigInt &x) {
+    is >> std::ws;
+    bool negative = is.peek() == '-';
+    if (negative)
+      is.get();
+    if (!std::isdigit(is.peek())) {
+      is.setstate(std::ios::failbit);
+      return is;
+    }
+    x = 0;
+    while (std::isdigit(is.peek()))
+      x = x * 10 + (is.get() - '0');
+    if (negative)
+      x = -x;
+    return is;
+  }
+  friend std::ostream &operator<<(std::ostream &os, BigInt x) {
+    std::string digits;
+    bool negative = x.isNegative();
+    BigInt magnitude = negative ? -x : x;
+    do {
+      uint64_t chunk = magnitude.divideSmall(1'000'000'000'000'000'000ull);
+      for (int i = 0; i < 18; ++i, chunk /= 10)
+        digits.push_back(static_cast<char>('0' + chunk % 10));
+    } while (!magnitude.isZero());
+    while (digits.size() > 1 && digits.back() == '0')
+      digits.pop_back();
+    if (negative)
+      digits.push_back('-');
+    return os << std::string(digits.rbegin(), digits.rend());
+  }
+
+private:
+  // Divides the non-negative *this by a small divisor in place
+  // and returns the remainder.
+  constexpr uint64_t divideSmall(uint64_t divisor) {
+    unsigned __int128 remainder = 0;
+    for (size_t i = N; i-- > 0;) {
+      unsigned __int128 current = (remainder << 64) | limbs[i];
+      limbs[i] = static_cast<uint64_t>(current / divisor);
+      remainder = current % divisor;
+    }
+    return static_cast<uint64_t>(remainder);
+  }
+
+  // Truncated division by shift-and-subtract on magnitudes.
+  //
+  // Quadratic in the number of bits, but division
+  // is rare in predicates: it is only needed for gcds
+  // when BigInt backs a Rational.
+  static constexpr void divide(BigInt dividend, BigInt divisor,
+                               BigInt &quotient, BigInt &remainder) {
+    bool negativeQuotient = dividend.isNegative() != divisor.isNegative();
+    bool negativeRemainder = dividend.isNegative();
+    if (dividend.isNegative())
+      dividend = -dividend;
+    if (divisor.isNegative())
+      divisor = -divisor;
+    if (divisor.isSmall()) {
+      quotient = dividend;
+      remainder = quotient.divideSmall(divisor.limbs[0]);
+    } else {
+      quotient = 0;
+      remainder = 0;
+      for (size_t bit = 64 * N; bit-- > 0;) {
+        remainder.shiftLeftOne();
+        remainder.limbs[0] |= (dividend.limbs[bit / 64] >> (bit % 64)) & 1;
+        if (!remainder.lessUnsigned(divisor)) {
+          remainder -= divisor;
+          quotient.limbs[bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+      }
+    }
+    if (negativeQuotient)
+      quotient = -quotient;
+    if (negativeRemainder)
+      remainder = -remainder;
+  }
+
+  // True iff only the lowest limb is non-zero.
+  constexpr bool isSmall() const {
+    for (size_t i = 1; i < N; ++i)
+      if (limbs[i])
+        return false;
+    return true;
+  }
+
+  // Comparison of the limbs as an unsigned number.
+  constexpr bool lessUnsigned(BigInt other) const {
+    for (size_t i = N; i-- > 0;)
+      if (limbs[i] != other.limbs[i])
+        return limbs[i] < other.limbs[i];
+    return false;
+  }
+
+  constexpr void shiftLeftOne() {
+    for (size_t i = N; i-- > 1;)
+      limbs[i] = (limbs[i] << 1) | (limbs[i - 1] >> 63);
+    limbs[0] <<= 1;
+  }
+};
+
+} // namespace numeric
+} // namespace acmlib
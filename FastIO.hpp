@@ -0,0 +1,542 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ACMLIB_FASTIO_MMAP
+#endif
+
+#include "Geometry.hpp"
+
+namespace acmlib {
+namespace io {
+
+namespace detail {
+
+// Powers of ten exactly representable in long double.
+constexpr long double exactPowersOfTen[] = {
+    1e0l,  1e1l,  1e2l,  1e3l,  1e4l,  1e5l,  1e6l,  1e7l,  1e8l,  1e9l,
+    1e10l, 1e11l, 1e12l, 1e13l, 1e14l, 1e15l, 1e16l, 1e17l, 1e18l, 1e19l,
+    1e20l, 1e21l, 1e22l, 1e23l, 1e24l, 1e25l, 1e26l, 1e27l};
+
+// mantissa * 10^exponent, with a single rounding
+// whenever the power of ten is exact.
+inline long double scaleByPowerOfTen(uint64_t mantissa, int32_t exponent) {
+  long double value = static_cast<long double>(mantissa);
+  if (mantissa == 0)
+    return value;
+  if (exponent >= 0 && exponent <= 27)
+    return value * exactPowersOfTen[exponent];
+  if (exponent < 0 && exponent >= -27)
+    return value / exactPowersOfTen[-exponent];
+  return value * std::pow(10.0l, static_cast<long double>(exponent));
+}
+
+// "00" "01" ... "99": two decimal digits at a time
+// halve the number of divisions when printing integers.
+constexpr std::array<char, 200> makeDigitPairs() {
+  std::array<char, 200> pairs{};
+  for (int i = 0; i < 100; ++i) {
+    pairs[2 * i] = static_cast<char>('0' + i / 10);
+    pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+  }
+  return pairs;
+}
+
+inline constexpr std::array<char, 200> digitPairs = makeDigitPairs();
+
+// Writes the decimal digits of value so that they end
+// right before end, and returns their beginning.
+template <typename U>
+char *writeDigitsBackwards(char *end, U value) {
+  while (value >= 100) {
+    unsigned pair = static_cast<unsigned>(value % 100);
+    value /= 100;
+    end -= 2;
+    std::memcpy(end, &digitPairs[2 * pair], 2);
+  }
+  if (value >= 10) {
+    end -= 2;
+    std::memcpy(end, &digitPairs[2 * static_cast<unsigned>(value)], 2);
+  } else {
+    *--end = static_cast<char>('0' + static_cast<unsigned>(value));
+  }
+  return end;
+}
+
+// A read-only memory mapping of a whole regular file;
+// empty if the file is not regular or cannot be mapped.
+class MappedFile {
+public:
+  MappedFile() = default;
+
+  // Maps the file open as the given descriptor,
+  // advising the kernel of sequential access if requested.
+  MappedFile(int descriptor, bool sequential) {
+#ifdef ACMLIB_FASTIO_MMAP
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || !S_ISREG(info.st_mode) ||
+        info.st_size == 0)
+      return;
+    void *data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE,
+                      descriptor, 0);
+    if (data == MAP_FAILED)
+      return;
+    madvise(data, info.st_size, sequential ? MADV_SEQUENTIAL : MADV_WILLNEED);
+    bytes = static_cast<const char *>(data);
+    length = info.st_size;
+#else
+    (void)descriptor;
+    (void)sequential;
+#endif
+  }
+
+  MappedFile(MappedFile &&other) noexcept
+      : bytes(std::exchange(other.bytes, nullptr)),
+        length(std::exchange(other.length, 0)) {}
+  MappedFile &operator=(MappedFile &&other) noexcept {
+    std::swap(bytes, other.bytes);
+    std::swap(length, other.length);
+    return *this;
+  }
+
+  ~MappedFile() {
+#ifdef ACMLIB_FASTIO_MMAP
+    if (bytes)
+      munmap(const_cast<char *>(bytes), length);
+#endif
+  }
+
+  const char *data() const { return bytes; }
+  size_t size() const { return length; }
+
+private:
+  const char *bytes = nullptr;
+  size_t length = 0;
+};
+
+} // namespace detail
+
+// A fast input reader replacing std::istream.
+//
+// A regular file (stdin redirected from a file included)
+// is mapped into memory and parsed in place; pipes and
+// terminals are read through a large buffer.
+// Numbers are parsed directly from the bytes,
+// without locales and virtual calls.
+//
+// Like a stream, the reader converts to false once a read
+// fails, e.g. at the end of input or on an integer out of
+// the range of its type; values are left intact then.
+// A sign must be followed directly by the number.
+class Reader {
+public:
+  // Reads the given file from its current position.
+  explicit Reader(std::FILE *file = stdin) : file(file) {
+#ifdef ACMLIB_FASTIO_MMAP
+    int descriptor = fileno(file);
+    off_t offset = lseek(descriptor, 0, SEEK_CUR);
+    if (offset >= 0) {
+      mapping = detail::MappedFile(descriptor, true);
+      if (mapping.size() > static_cast<size_t>(offset)) {
+        position = mapping.data() + offset;
+        end = mapping.data() + mapping.size();
+        return;
+      }
+    }
+#endif
+    buffer.resize(bufferSize);
+  }
+
+  // Reads the given bytes, which must outlive the reader.
+  Reader(const char *data, size_t size)
+      : file(nullptr), position(data), end(data + size) {}
+
+  Reader(const Reader &) = delete;
+  Reader &operator=(const Reader &) = delete;
+
+  // False once a read has failed.
+  explicit operator bool() const { return !failed; }
+
+  // Skips whitespace and returns the next character
+  // without consuming it, or EOF.
+  int peek() { return skipSpace(); }
+
+  // Integers, including __int128.
+  template <typename I>
+  std::enable_if_t<(std::is_integral<I>::value ||
+                    std::is_same<I, __int128>::value) &&
+                       !std::is_same<I, char>::value &&
+                       !std::is_same<I, bool>::value,
+                   Reader &>
+  operator>>(I &x) {
+    int c = skipSpace();
+    bool negative = c == '-';
+    if (c == '-' || c == '+')
+      c = advance();
+    if (!isDigit(c))
+      return fail();
+    using U = std::conditional_t<std::is_same<I, __int128>::value,
+                                 unsigned __int128, std::make_unsigned_t<I>>;
+    // The largest magnitude: one more for negative signed values.
+    constexpr bool isSigned = I(-1) < I(0);
+    U limit = (isSigned ? U(~U(0)) >> 1 : U(~U(0))) + (isSigned && negative);
+    // The first digits10 digits cannot overflow U.
+    constexpr int safeDigits = sizeof(U) * 8 * 30103 / 100000;
+    U value = 0;
+    for (int digits = 0; isDigit(c) && digits < safeDigits; ++digits) {
+      value = value * 10 + static_cast<U>(c - '0');
+      c = advance();
+    }
+    bool overflow = false;
+    for (; isDigit(c); c = advance()) {
+      overflow |= __builtin_mul_overflow(value, U(10), &value);
+      overflow |= __builtin_add_overflow(value, U(c - '0'), &value);
+    }
+    if (overflow || value > limit)
+      return fail();
+    x = static_cast<I>(negative ? U(0) - value : value);
+    return *this;
+  }
+
+  // Floating-point numbers in decimal notation
+  // with an optional exponent; other spellings like
+  // inf or hexadecimal floats go through strtold.
+  template <typename F>
+  std::enable_if_t<std::is_floating_point<F>::value, Reader &>
+  operator>>(F &x) {
+    int c = skipSpace();
+    bool negative = c == '-';
+    if (c == '-' || c == '+')
+      c = advance();
+    if (!isDigit(c) && c != '.')
+      return readSpecial(x, negative);
+    uint64_t mantissa = 0;
+    int32_t significant = 0, exponent = 0;
+    bool digits = false;
+    for (; isDigit(c); c = advance(), digits = true) {
+      if (significant < 19) {
+        mantissa = mantissa * 10 + (c - '0');
+        significant += mantissa != 0;
+      } else {
+        ++exponent;
+      }
+    }
+    if (c == '.') {
+      for (c = advance(); isDigit(c); c = advance(), digits = true) {
+        if (significant < 19) {
+          mantissa = mantissa * 10 + (c - '0');
+          significant += mantissa != 0;
+          --exponent;
+        }
+      }
+    }
+    if (!digits)
+      return fail();
+    if (c == 'e' || c == 'E') {
+      c = advance();
+      bool negativeExponent = c == '-';
+      if (c == '-' || c == '+')
+        c = advance();
+      int32_t power = 0;
+      for (; isDigit(c); c = advance())
+        if (power < 100000)
+          power = power * 10 + (c - '0');
+      exponent += negativeExponent ? -power : power;
+    }
+    long double value = detail::scaleByPowerOfTen(mantissa, exponent);
+    x = static_cast<F>(negative ? -value : value);
+    return *this;
+  }
+
+  // A single non-whitespace character.
+  Reader &operator>>(char &x) {
+    int c = skipSpace();
+    if (c == EOF)
+      return fail();
+    x = static_cast<char>(c);
+    advance();
+    return *this;
+  }
+
+  // A whitespace-delimited word.
+  Reader &operator>>(std::string &x) {
+    if (skipSpace() == EOF)
+      return fail();
+    readWord(x);
+    return *this;
+  }
+
+  // Reads n consecutive values into an array.
+  template <typename T>
+  Reader &read(T *data, size_t n) {
+    for (size_t i = 0; i < n && !failed; ++i)
+      *this >> data[i];
+    return *this;
+  }
+
+  // Reads values.size() values into a vector.
+  template <typename T>
+  Reader &read(std::vector<T> &values) {
+    return read(values.data(), values.size());
+  }
+
+private:
+  static constexpr size_t bufferSize = 1 << 16;
+
+  static bool isDigit(int c) { return static_cast<unsigned>(c - '0') < 10; }
+  static bool isSpace(int c) { return c != EOF && c <= ' '; }
+
+  Reader &fail() {
+    failed = true;
+    return *this;
+  }
+
+  // The current character or EOF.
+  int current() {
+    if (position == end && !refill())
+      return EOF;
+    return static_cast<unsigned char>(*position);
+  }
+
+  // Consumes the current character and returns the next one.
+  int advance() {
+    ++position;
+    return current();
+  }
+
+  int skipSpace() {
+    int c = current();
+    while (isSpace(c))
+      c = advance();
+    return c;
+  }
+
+  // The characters up to the next whitespace, possibly none.
+  void readWord(std::string &x) {
+    x.clear();
+    for (int c = current(); c != EOF && !isSpace(c); c = advance())
+      x.push_back(static_cast<char>(c));
+  }
+
+  // Loads the next part of a non-mapped file.
+  bool refill() {
+    if (!file || buffer.empty())
+      return false;
+    size_t size = std::fread(buffer.data(), 1, buffer.size(), file);
+    position = buffer.data();
+    end = position + size;
+    return size > 0;
+  }
+
+  // Words like inf and nan right after the sign,
+  // parsed by strtold.
+  template <typename F>
+  Reader &readSpecial(F &x, bool negative) {
+    std::string word;
+    readWord(word);
+    const char *begin = word.c_str();
+    char *last;
+    long double value = std::strtold(begin, &last);
+    if (word.empty() || *last != '\0')
+      return fail();
+    x = static_cast<F>(negative ? -value : value);
+    return *this;
+  }
+
+  std::FILE *file;
+  std::vector<char> buffer;
+  detail::MappedFile mapping;
+  const char *position = nullptr;
+  const char *end = nullptr;
+  bool failed = false;
+};
+
+// A fast output writer replacing std::ostream.
+//
+// Output is collected in a large buffer and written out
+// when it fills up, on flush and on destruction.
+// Integers are printed two digits at a time, floating-point
+// numbers by std::to_chars: by default in the shortest form
+// that reads back to the same value, or with a fixed number
+// of digits after the point, see setPrecision.
+//
+// Do not mix with other output to the same file
+// without flushing in between.
+class Writer {
+public:
+  // Writes to the given file.
+  explicit Writer(std::FILE *file = stdout) : file(file), buffer(bufferSize) {}
+
+  Writer(const Writer &) = delete;
+  Writer &operator=(const Writer &) = delete;
+
+  ~Writer() { flush(); }
+
+  // Writes the buffered output to the file.
+  void flush() {
+    if (size)
+      std::fwrite(buffer.data(), 1, size, file);
+    size = 0;
+    std::fflush(file);
+  }
+
+  // Floating-point numbers are printed with the given number
+  // of digits after the decimal point, or in the shortest
+  // round-trip form if digits is negative (the default).
+  void setPrecision(int32_t digits) { precision = digits; }
+
+  // Integers, including __int128.
+  template <typename I>
+  std::enable_if_t<(std::is_integral<I>::value ||
+                    std::is_same<I, __int128>::value) &&
+                       !std::is_same<I, char>::value &&
+                       !std::is_same<I, bool>::value,
+                   Writer &>
+  operator<<(I x) {
+    using U = std::conditional_t<std::is_same<I, __int128>::value,
+                                 unsigned __int128, std::make_unsigned_t<I>>;
+    char digits[48], *end = digits + sizeof(digits);
+    bool negative = x < 0;
+    char *begin = detail::writeDigitsBackwards(
+        end, negative ? U(0) - static_cast<U>(x) : static_cast<U>(x));
+    if (negative)
+      *--begin = '-';
+    return write(begin, end - begin);
+  }
+
+  // Floating-point numbers, see setPrecision.
+  template <typename F>
+  std::enable_if_t<std::is_floating_point<F>::value, Writer &>
+  operator<<(F x) {
+    for (int attempt = 0; attempt < 2; ++attempt) {
+      std::to_chars_result result = format(
+          buffer.data() + size, buffer.data() + buffer.size(), x);
+      if (result.ec == std::errc()) {
+        size = result.ptr - buffer.data();
+        return *this;
+      }
+      flush();
+    }
+    // Longer than the whole buffer: huge numbers in fixed notation.
+    std::vector<char> text(5000 + std::max(precision, 0));
+    std::to_chars_result result =
+        format(text.data(), text.data() + text.size(), x);
+    return write(text.data(), result.ptr - text.data());
+  }
+
+  Writer &operator<<(char c) {
+    if (size == buffer.size())
+      flush();
+    buffer[size++] = c;
+    return *this;
+  }
+  // As 1 or 0, like std::ostream without boolalpha.
+  Writer &operator<<(bool b) { return *this << (b ? '1' : '0'); }
+  Writer &operator<<(const char *s) { return write(s, std::strlen(s)); }
+  Writer &operator<<(const std::string &s) { return write(s.data(), s.size()); }
+
+  // Elements of a vector, each followed by a space,
+  // like the std::ostream operator in Template.cpp.
+  template <typename T>
+  Writer &operator<<(const std::vector<T> &values) {
+    for (const T &value : values)
+      *this << value << ' ';
+    return *this;
+  }
+
+  // Writes n values from an array, separated by separator.
+  template <typename T>
+  Writer &write(const T *values, size_t n, char separator = ' ') {
+    for (size_t i = 0; i < n; ++i) {
+      if (i)
+        *this << separator;
+      *this << values[i];
+    }
+    return *this;
+  }
+
+  // Writes n raw characters.
+  Writer &write(const char *data, size_t n) {
+    if (size + n > buffer.size()) {
+      flush();
+      if (n > buffer.size()) {
+        std::fwrite(data, 1, n, file);
+        return *this;
+      }
+    }
+    std::memcpy(buffer.data() + size, data, n);
+    size += n;
+    return *this;
+  }
+
+private:
+  static constexpr size_t bufferSize = 1 << 16;
+
+  template <typename F>
+  std::to_chars_result format(char *first, char *last, F x) const {
+    if (precision < 0)
+      return std::to_chars(first, last, x);
+    return std::to_chars(first, last, x, std::chars_format::fixed, precision);
+  }
+
+  std::FILE *file;
+  std::vector<char> buffer;
+  size_t size = 0;
+  int32_t precision = -1;
+};
+
+// Overloads for geometry types, in the same layout
+// as their std::istream and std::ostream operators.
+inline Reader &operator>>(Reader &in, geometry::Real &x) {
+  geometry::Real::PrimitiveReal value;
+  if (in >> value)
+    x = value;
+  return in;
+}
+template <typename T>
+Reader &operator>>(Reader &in, geometry::Vector<T> &v) {
+  return in >> v.x() >> v.y();
+}
+template <typename T>
+Reader &operator>>(Reader &in, geometry::Line<T> &l) {
+  return in >> l.a() >> l.b() >> l.c();
+}
+template <typename T>
+Reader &operator>>(Reader &in, geometry::Matrix<T> &m) {
+  return in >> m.a() >> m.b() >> m.c() >> m.d();
+}
+
+inline Writer &operator<<(Writer &out, geometry::Real x) {
+  return out << static_cast<geometry::Real::PrimitiveReal>(x);
+}
+template <typename T>
+Writer &operator<<(Writer &out, geometry::Vector<T> v) {
+  return out << v.x() << ' ' << v.y();
+}
+template <typename T>
+Writer &operator<<(Writer &out, geometry::Line<T> l) {
+  return out << l.a() << ' ' << l.b() << ' ' << l.c();
+}
+template <typename T>
+Writer &operator<<(Writer &out, geometry::Matrix<T> m) {
+  return out << m.a() << ' ' << m.b() << ' ' << m.c() << ' ' << m.d();
+}
+
+} // namespace io
+} // namespace acmlib
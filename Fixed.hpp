@@ -0,0 +1,375 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+
+namespace acmlib {
+namespace numeric {
+
+namespace detail {
+
+// Constants in fixed point with 61 fractional bits,
+// precomputed so that no floating-point math is involved.
+constexpr int64_t fixedPi = 7244019458077122842;
+// The CORDIC gain compensation: product of 1 / sqrt(1 + 4^-i).
+constexpr int64_t fixedCordicGain = 1400229935014726477;
+// atan(2^-i) for i = 0, ..., 20;
+// for larger i it rounds to exactly 2^(61 - i).
+constexpr int64_t fixedAtanTable[21] = {
+    1811004864519280711, 1069098597953152948, 564882337777596249,
+    286743094836456889,  143927976672616092,  72034151524184357,
+    36025865417378411,   18014032019027246,   9007153442175927,
+    4503593900760542,    2251799097857775,    1125899817364151,
+    562949942236502,     281474975312555,     140737488180565,
+    70368744155819,      35184372086101,      17592186044075,
+    8796093022165,       4398046511099,       2199023255551};
+constexpr int fixedCordicSteps = 62;
+
+constexpr int64_t fixedAtan(int i) {
+  return i < 21 ? fixedAtanTable[i] : int64_t(1) << (61 - i);
+}
+
+// Integer square root: the largest r with r * r <= x.
+template <typename U>
+constexpr U isqrt(U x) {
+  U result = 0;
+  U bit = U(1) << (sizeof(U) * 8 - 2);
+  while (bit > x)
+    bit >>= 2;
+  while (bit) {
+    if (x >= result + bit) {
+      x -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return result;
+}
+
+} // namespace detail
+
+// A signed fixed-point number with IntBits integral
+// and FracBits fractional bits, i.e. an integer multiple
+// of 2^-FracBits in [-2^IntBits, 2^IntBits).
+//
+// A drop-in alternative to Real with the same interface,
+// for computations which must give bit-identical results
+// on every machine and compiler: all operations, including
+// sqrt, sin, cos and atan2, are done in integer arithmetic.
+// Arrays of Fixed are plain integer arrays, so loops
+// over them vectorize as integer SIMD.
+//
+// Values are stored in int32_t when they fit into 32 bits
+// and in int64_t otherwise. Products and quotients use
+// a twice as wide intermediate and are rounded to nearest.
+// Addition, subtraction and negation wrap around modulo
+// the width of the underlying integer; they are done
+// in its unsigned type, since signed overflow is undefined
+// and could be exploited differently by each compiler.
+//
+// Unlike Real, comparisons are exact.
+template <int IntBits, int FracBits>
+class Fixed {
+  static_assert(IntBits >= 0 && FracBits >= 0);
+  static_assert(IntBits + FracBits <= 63 && FracBits <= 61);
+
+public:
+  // Underlying integer type and the type of intermediates.
+  using Raw = std::conditional_t<IntBits + FracBits <= 31, int32_t, int64_t>;
+  using URaw = std::make_unsigned_t<Raw>;
+  using Wide = std::conditional_t<IntBits + FracBits <= 31, int64_t, __int128>;
+  using UnsignedWide = std::conditional_t<IntBits + FracBits <= 31, uint64_t,
+                                          unsigned __int128>;
+
+  static constexpr Raw one = Raw(1) << FracBits;
+
+private:
+  Raw value;
+
+public:
+  // Default constructor: zero value.
+  constexpr Fixed() : value(0) {}
+
+  // Construct from a numeric type, rounding to the nearest
+  // representable value.
+  template <typename T, typename = std::enable_if_t<
+                            std::is_arithmetic<T>::value ||
+                            std::is_same<T, __int128>::value>>
+  constexpr Fixed(T x) : value(0) {
+    if constexpr (std::is_floating_point<T>::value) {
+      T scaled = x * static_cast<T>(one);
+      value = static_cast<Raw>(scaled < 0 ? scaled - T(0.5) : scaled + T(0.5));
+    } else {
+      value = static_cast<Raw>(static_cast<Wide>(x) * one);
+    }
+  }
+
+  // Conversion between fixed-point formats, rounding to nearest.
+  template <int I, int F>
+  constexpr explicit Fixed(Fixed<I, F> other)
+      : value(convertRaw<FracBits, F>(other.raw())) {}
+
+  // Construct from the raw underlying integer.
+  static constexpr Fixed fromRaw(Raw raw) {
+    Fixed result;
+    result.value = raw;
+    return result;
+  }
+  constexpr Raw raw() const { return value; }
+
+  // Explicit conversion to primitive types.
+  // Integer conversions truncate towards zero.
+  template <typename U>
+  constexpr explicit operator U() const {
+    if constexpr (std::is_floating_point<U>::value)
+      return static_cast<U>(value) / static_cast<U>(one);
+    else
+      return static_cast<U>(value / one);
+  }
+
+  // Arithmetic operators.
+  constexpr Fixed &operator+=(Fixed other) {
+    value = wrap(URaw(value) + URaw(other.value));
+    return *this;
+  }
+  constexpr Fixed &operator-=(Fixed other) {
+    value = wrap(URaw(value) - URaw(other.value));
+    return *this;
+  }
+  constexpr Fixed &operator*=(Fixed other) {
+    Wide product = static_cast<Wide>(value) * other.value;
+    value = static_cast<Raw>(roundShift(product, FracBits));
+    return *this;
+  }
+  constexpr Fixed &operator/=(Fixed other) {
+    Wide dividend = static_cast<Wide>(value) * one;
+    Wide quotient = dividend / other.value;
+    Wide remainder = dividend % other.value;
+    // Round half away from zero.
+    Wide absRemainder = remainder < 0 ? -remainder : remainder;
+    Wide absDivisor = other.value < 0 ? -Wide(other.value) : other.value;
+    if (2 * absRemainder >= absDivisor)
+      quotient += (dividend < 0) == (other.value < 0) ? 1 : -1;
+    value = static_cast<Raw>(quotient);
+    return *this;
+  }
+  constexpr friend Fixed operator+(Fixed lhs, Fixed rhs) { return lhs += rhs; }
+  constexpr friend Fixed operator-(Fixed lhs, Fixed rhs) { return lhs -= rhs; }
+  constexpr friend Fixed operator*(Fixed lhs, Fixed rhs) { return lhs *= rhs; }
+  constexpr friend Fixed operator/(Fixed lhs, Fixed rhs) { return lhs /= rhs; }
+  constexpr Fixed operator+() const { return *this; }
+  constexpr Fixed operator-() const { return fromRaw(wrap(-URaw(value))); }
+  constexpr Fixed &operator++() {
+    *this += fromRaw(one);
+    return *this;
+  }
+  constexpr Fixed operator++(int32_t) {
+    Fixed copy = *this;
+    ++*this;
+    return copy;
+  }
+  constexpr Fixed &operator--() {
+    *this -= fromRaw(one);
+    return *this;
+  }
+  constexpr Fixed operator--(int32_t) {
+    Fixed copy = *this;
+    --*this;
+    return copy;
+  }
+
+  // Comparison operators, exact.
+  constexpr friend bool operator==(Fixed lhs, Fixed rhs) {
+    return lhs.value == rhs.value;
+  }
+  constexpr friend bool operator!=(Fixed lhs, Fixed rhs) {
+    return lhs.value != rhs.value;
+  }
+  constexpr friend bool operator<(Fixed lhs, Fixed rhs) {
+    return lhs.value < rhs.value;
+  }
+  constexpr friend bool operator>(Fixed lhs, Fixed rhs) {
+    return lhs.value > rhs.value;
+  }
+  constexpr friend bool operator<=(Fixed lhs, Fixed rhs) {
+    return lhs.value <= rhs.value;
+  }
+  constexpr friend bool operator>=(Fixed lhs, Fixed rhs) {
+    return lhs.value >= rhs.value;
+  }
+
+  // I/O stream operators.
+  //
+  // The text form is decimal, so it is only
+  // as deterministic as the platform's long double.
+  friend std::istream &operator>>(std::istream &is, Fixed &x) {
+    long double value;
+    if (is >> value)
+      x = value;
+    return is;
+  }
+  friend std::ostream &operator<<(std::ostream &os, Fixed x) {
+    return os << static_cast<long double>(x);
+  }
+
+  // Rounds x / 2^shift to nearest, ties towards +infinity.
+  template <typename W>
+  static constexpr W roundShift(W x, int shift) {
+    if (shift == 0)
+      return x;
+    return (x + (W(1) << (shift - 1))) >> shift;
+  }
+
+  // The raw value with the bits of an unsigned result;
+  // the conversion is modulo 2^n with GCC and Clang,
+  // and by the standard since C++20.
+  static constexpr Raw wrap(URaw x) { return static_cast<Raw>(x); }
+
+  // Raw value with From fractional bits converted to To fractional bits.
+  template <int To, int From, typename W>
+  static constexpr Raw convertRaw(W raw) {
+    Wide wide = static_cast<Wide>(raw);
+    if constexpr (To >= From)
+      return static_cast<Raw>(wide * (Wide(1) << (To - From)));
+    else
+      return static_cast<Raw>(roundShift(wide, From - To));
+  }
+};
+
+// Type aliases for common formats.
+using Fixed32 = Fixed<15, 16>;
+using Fixed64 = Fixed<31, 32>;
+
+// Overloads of some functions from <cmath> for Fixed,
+// all in deterministic integer arithmetic.
+template <int I, int F>
+constexpr Fixed<I, F> fabs(Fixed<I, F> x) {
+  return x < 0 ? -x : x;
+}
+template <int I, int F>
+constexpr Fixed<I, F> floor(Fixed<I, F> x) {
+  using Raw = typename Fixed<I, F>::Raw;
+  return Fixed<I, F>::fromRaw(x.raw() & ~(Raw(Fixed<I, F>::one) - 1));
+}
+template <int I, int F>
+constexpr Fixed<I, F> ceil(Fixed<I, F> x) {
+  return -floor(-x);
+}
+
+// Square root of x >= 0, rounded down.
+template <int I, int F>
+constexpr Fixed<I, F> sqrt(Fixed<I, F> x) {
+  using Raw = typename Fixed<I, F>::Raw;
+  using Unsigned = typename Fixed<I, F>::UnsignedWide;
+  if (x.raw() <= 0)
+    return Fixed<I, F>();
+  Unsigned scaled = static_cast<Unsigned>(x.raw()) << F;
+  return Fixed<I, F>::fromRaw(static_cast<Raw>(detail::isqrt(scaled)));
+}
+
+// atan2(y, x) in [-pi, pi] by CORDIC vectoring.
+//
+// Requires at least 2 integral bits to hold pi.
+template <int I, int F>
+constexpr Fixed<I, F> atan2(Fixed<I, F> y, Fixed<I, F> x) {
+  static_assert(I >= 2, "atan2 needs room for pi");
+  if (x.raw() == 0 && y.raw() == 0)
+    return Fixed<I, F>();
+  // Work with magnitudes scaled into [2^59, 2^60):
+  // the angle only depends on their ratio.
+  // Magnitudes are taken unsigned, which also holds
+  // the one of the minimum.
+  auto magnitude = [](int64_t v) {
+    return v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+  };
+  uint64_t ux = magnitude(x.raw()), uy = magnitude(y.raw());
+  while ((ux | uy) >= (uint64_t(1) << 60)) {
+    ux >>= 1;
+    uy >>= 1;
+  }
+  int64_t ax = static_cast<int64_t>(ux), ay = static_cast<int64_t>(uy);
+  while ((ax | ay) < (int64_t(1) << 59)) {
+    ax <<= 1;
+    ay <<= 1;
+  }
+  int64_t angle = 0;
+  for (int i = 0; i < detail::fixedCordicSteps; ++i) {
+    int64_t dx = ax >> i, dy = ay >> i;
+    if (ay > 0) {
+      ax += dy;
+      ay -= dx;
+      angle += detail::fixedAtan(i);
+    } else {
+      ax -= dy;
+      ay += dx;
+      angle -= detail::fixedAtan(i);
+    }
+  }
+  if (x.raw() < 0)
+    angle = detail::fixedPi - angle;
+  if (y.raw() < 0)
+    angle = -angle;
+  using Raw = typename Fixed<I, F>::Raw;
+  return Fixed<I, F>::fromRaw(
+      static_cast<Raw>(Fixed<I, F>::roundShift(angle, 61 - F)));
+}
+
+// sin and cos at once by CORDIC rotation.
+template <int I, int F>
+constexpr void sincos(Fixed<I, F> x, Fixed<I, F> &s, Fixed<I, F> &c) {
+  using Raw = typename Fixed<I, F>::Raw;
+  // Reduce into [-pi, pi] with 61 fractional bits.
+  __int128 twoPi = __int128(detail::fixedPi) * 2;
+  __int128 angle = __int128(x.raw()) * (__int128(1) << (61 - F)) % twoPi;
+  if (angle > detail::fixedPi)
+    angle -= twoPi;
+  else if (angle < -detail::fixedPi)
+    angle += twoPi;
+  // Then into [-pi/2, pi/2], where CORDIC converges.
+  bool negateCos = false;
+  if (angle > detail::fixedPi / 2) {
+    angle = detail::fixedPi - angle;
+    negateCos = true;
+  } else if (angle < -detail::fixedPi / 2) {
+    angle = -detail::fixedPi - angle;
+    negateCos = true;
+  }
+  int64_t z = static_cast<int64_t>(angle);
+  int64_t cx = detail::fixedCordicGain, cy = 0;
+  for (int i = 0; i < detail::fixedCordicSteps; ++i) {
+    int64_t dx = cx >> i, dy = cy >> i;
+    if (z >= 0) {
+      cx -= dy;
+      cy += dx;
+      z -= detail::fixedAtan(i);
+    } else {
+      cx += dy;
+      cy -= dx;
+      z += detail::fixedAtan(i);
+    }
+  }
+  if (negateCos)
+    cx = -cx;
+  s = Fixed<I, F>::fromRaw(
+      static_cast<Raw>(Fixed<I, F>::roundShift(cy, 61 - F)));
+  c = Fixed<I, F>::fromRaw(
+      static_cast<Raw>(Fixed<I, F>::roundShift(cx, 61 - F)));
+}
+template <int I, int F>
+constexpr Fixed<I, F> sin(Fixed<I, F> x) {
+  Fixed<I, F> s, c;
+  sincos(x, s, c);
+  return s;
+}
+template <int I, int F>
+constexpr Fixed<I, F> cos(Fixed<I, F> x) {
+  Fixed<I, F> s, c;
+  sincos(x, s, c);
+  return c;
+}
+
+} // namespace numeric
+} // namespace acmlib
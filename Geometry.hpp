@@ -1,11 +1,133 @@
+#pragma once
+
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <numeric>
+#include <type_traits>
 
 namespace acmlib {
 namespace geometry {
 
+// Operation counts of the calling thread, collected when
+// ACMLIB_COUNT_OPERATIONS is defined before including this
+// header (in every translation unit of the program)
+// and all zero otherwise.
+struct OperationCounts {
+  // Real +, -, *, /, negation, increments and decrements.
+  uint64_t arithmetic = 0;
+  // Real epsilon comparisons.
+  uint64_t comparisons = 0;
+  // Comparisons whose operands differ by eps / 16 to 16 eps:
+  // their outcome depends on the choice of eps.
+  uint64_t ambiguous = 0;
+  // libm functions called on Real.
+  uint64_t libm = 0;
+  // Vector operators, with any coordinate type.
+  uint64_t vector = 0;
+
+  OperationCounts &operator-=(const OperationCounts &other) {
+    arithmetic -= other.arithmetic;
+    comparisons -= other.comparisons;
+    ambiguous -= other.ambiguous;
+    libm -= other.libm;
+    vector -= other.vector;
+    return *this;
+  }
+  friend OperationCounts operator-(OperationCounts lhs,
+                                   const OperationCounts &rhs) {
+    return lhs -= rhs;
+  }
+
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const OperationCounts &counts) {
+    return os << counts.arithmetic << " arithmetic, " << counts.comparisons
+              << " comparisons (" << counts.ambiguous << " ambiguous), "
+              << counts.libm << " libm, " << counts.vector << " vector";
+  }
+};
+
+// Running totals of the calling thread.
+inline OperationCounts &operationCounts() {
+  static thread_local OperationCounts counts;
+  return counts;
+}
+
+// Operation counts since construction, e.g.
+//
+//   OperationCountScope scope("hull");
+//   ...
+//   scope.counts().ambiguous
+//
+// A named scope prints its counts to std::cerr when destroyed.
+class OperationCountScope {
+public:
+  explicit OperationCountScope(const char *name = nullptr)
+      : name(name), start(operationCounts()) {}
+
+  OperationCountScope(const OperationCountScope &) = delete;
+  OperationCountScope &operator=(const OperationCountScope &) = delete;
+
+  ~OperationCountScope() {
+    if (name)
+      std::cerr << name << ": " << counts() << std::endl;
+  }
+
+  OperationCounts counts() const { return operationCounts() - start; }
+
+private:
+  const char *name;
+  OperationCounts start;
+};
+
+// Epsilon comparisons, see Real.
+enum class Comparison {
+  Equal,
+  NotEqual,
+  Less,
+  Greater,
+  LessEqual,
+  GreaterEqual,
+};
+
+namespace detail {
+
+// Adds one to a field of the operation counts, outside
+// of constant evaluation; a no-op unless counting is enabled.
+constexpr void countOperation(
+    [[maybe_unused]] uint64_t OperationCounts::*kind) {
+#ifdef ACMLIB_COUNT_OPERATIONS
+  if (!__builtin_is_constant_evaluated())
+    ++(operationCounts().*kind);
+#endif
+}
+
+// lhs C rhs with tolerance eps in the floating-point type F.
+//
+// Branch-free: with F = double it compiles to SSE compares
+// and loops over it are vectorized.
+template <Comparison C, typename F>
+constexpr bool epsilonCompare(F lhs, F rhs, F eps) {
+  if constexpr (C == Comparison::Equal)
+    return std::fabs(lhs - rhs) < eps;
+  else if constexpr (C == Comparison::NotEqual)
+    return std::fabs(lhs - rhs) >= eps;
+  else if constexpr (C == Comparison::Less)
+    return lhs <= rhs - eps;
+  else if constexpr (C == Comparison::Greater)
+    return lhs >= rhs + eps;
+  else if constexpr (C == Comparison::LessEqual)
+    return lhs < rhs + eps;
+  else
+    return lhs > rhs - eps;
+}
+
+} // namespace detail
+
 // A helper class for real number computation,
 // which overrides comparison operators
 // to compare reals with epsilon-precision.
@@ -39,18 +161,22 @@ public:
 
   // Arithmetic operators.
   constexpr Real &operator+=(Real other) {
+    detail::countOperation(&OperationCounts::arithmetic);
     value += other.value;
     return *this;
   }
   constexpr Real &operator-=(Real other) {
+    detail::countOperation(&OperationCounts::arithmetic);
     value -= other.value;
     return *this;
   }
   constexpr Real &operator*=(Real other) {
+    detail::countOperation(&OperationCounts::arithmetic);
     value *= other.value;
     return *this;
   }
   constexpr Real &operator/=(Real other) {
+    detail::countOperation(&OperationCounts::arithmetic);
     value /= other.value;
     return *this;
   }
@@ -59,46 +185,75 @@ public:
   constexpr friend Real operator*(Real lhs, Real rhs) { return lhs *= rhs; }
   constexpr friend Real operator/(Real lhs, Real rhs) { return lhs /= rhs; }
   constexpr Real operator+() const { return *this; }
-  constexpr Real operator-() const { return -value; }
+  constexpr Real operator-() const {
+    detail::countOperation(&OperationCounts::arithmetic);
+    return -value;
+  }
   constexpr Real &operator++() {
+    detail::countOperation(&OperationCounts::arithmetic);
     ++value;
     return *this;
   }
   constexpr Real operator++(int32_t) {
     Real copy = *this;
+    detail::countOperation(&OperationCounts::arithmetic);
     ++value;
     return copy;
   }
   constexpr Real &operator--() {
+    detail::countOperation(&OperationCounts::arithmetic);
     --value;
     return *this;
   }
   constexpr Real operator--(int32_t) {
     Real copy = *this;
+    detail::countOperation(&OperationCounts::arithmetic);
     --value;
     return copy;
   }
 
   // Comparison operators with epsilon precision.
   constexpr friend bool operator==(Real lhs, Real rhs) {
-    return std::fabs(lhs.value - rhs.value) < eps;
+    return epsilonCompare<Comparison::Equal>(lhs, rhs);
   }
   constexpr friend bool operator!=(Real lhs, Real rhs) {
-    return std::fabs(lhs.value - rhs.value) >= eps;
+    return epsilonCompare<Comparison::NotEqual>(lhs, rhs);
   }
   constexpr friend bool operator<(Real lhs, Real rhs) {
-    return lhs.value <= rhs.value - eps;
+    return epsilonCompare<Comparison::Less>(lhs, rhs);
   }
   constexpr friend bool operator>(Real lhs, Real rhs) {
-    return lhs.value >= rhs.value + eps;
+    return epsilonCompare<Comparison::Greater>(lhs, rhs);
   }
   constexpr friend bool operator<=(Real lhs, Real rhs) {
-    return lhs.value < rhs.value + eps;
+    return epsilonCompare<Comparison::LessEqual>(lhs, rhs);
   }
   constexpr friend bool operator>=(Real lhs, Real rhs) {
-    return lhs.value > rhs.value - eps;
+    return epsilonCompare<Comparison::GreaterEqual>(lhs, rhs);
+  }
+
+private:
+  template <Comparison C>
+  static constexpr bool epsilonCompare(Real lhs, Real rhs) {
+    countComparison(lhs, rhs);
+    return detail::epsilonCompare<C>(lhs.value, rhs.value, eps);
+  }
+
+  // Counts a comparison and whether it is ambiguous,
+  // see OperationCounts.
+  static constexpr void countComparison([[maybe_unused]] Real lhs,
+                                        [[maybe_unused]] Real rhs) {
+#ifdef ACMLIB_COUNT_OPERATIONS
+    if (__builtin_is_constant_evaluated())
+      return;
+    OperationCounts &counts = operationCounts();
+    ++counts.comparisons;
+    PrimitiveReal difference = std::fabs(lhs.value - rhs.value);
+    counts.ambiguous += difference >= eps / 16 && difference < eps * 16;
+#endif
   }
 
+public:
   // I/O stream operators.
   friend std::istream &operator>>(std::istream &is, Real &x) {
     return is >> x.value;
@@ -109,28 +264,344 @@ public:
 };
 
 // Overloads of some functions from <cmath> for Real type.
-inline Real acos(Real x) { return std::acos((Real::PrimitiveReal)x); }
-inline Real asin(Real x) { return std::asin((Real::PrimitiveReal)x); }
-inline Real atan(Real x) { return std::atan((Real::PrimitiveReal)x); }
+inline Real acos(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::acos((Real::PrimitiveReal)x);
+}
+inline Real asin(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::asin((Real::PrimitiveReal)x);
+}
+inline Real atan(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::atan((Real::PrimitiveReal)x);
+}
 inline Real atan2(Real y, Real x) {
+  detail::countOperation(&OperationCounts::libm);
   return std::atan2((Real::PrimitiveReal)y, (Real::PrimitiveReal)x);
 }
-inline Real ceil(Real x) { return std::ceil((Real::PrimitiveReal)x); }
-inline Real cos(Real x) { return std::cos((Real::PrimitiveReal)x); }
-inline Real cosh(Real x) { return std::cosh((Real::PrimitiveReal)x); }
-inline Real exp(Real x) { return std::exp((Real::PrimitiveReal)x); }
-inline Real fabs(Real x) { return std::fabs((Real::PrimitiveReal)x); }
-inline Real floor(Real x) { return std::floor((Real::PrimitiveReal)x); }
-inline Real log(Real x) { return std::log((Real::PrimitiveReal)x); }
-inline Real log10(Real x) { return std::log10((Real::PrimitiveReal)x); }
+inline Real ceil(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::ceil((Real::PrimitiveReal)x);
+}
+inline Real cos(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::cos((Real::PrimitiveReal)x);
+}
+inline Real cosh(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::cosh((Real::PrimitiveReal)x);
+}
+inline Real exp(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::exp((Real::PrimitiveReal)x);
+}
+inline Real fabs(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::fabs((Real::PrimitiveReal)x);
+}
+inline Real floor(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::floor((Real::PrimitiveReal)x);
+}
+inline Real log(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::log((Real::PrimitiveReal)x);
+}
+inline Real log10(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::log10((Real::PrimitiveReal)x);
+}
 inline Real pow(Real x, Real y) {
+  detail::countOperation(&OperationCounts::libm);
   return std::pow((Real::PrimitiveReal)x, (Real::PrimitiveReal)y);
 }
-inline Real sin(Real x) { return std::sin((Real::PrimitiveReal)x); }
-inline Real sinh(Real x) { return std::sinh((Real::PrimitiveReal)x); }
-inline Real sqrt(Real x) { return std::sqrt((Real::PrimitiveReal)x); }
-inline Real tan(Real x) { return std::tan((Real::PrimitiveReal)x); }
-inline Real tanh(Real x) { return std::tanh((Real::PrimitiveReal)x); }
+inline Real sin(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::sin((Real::PrimitiveReal)x);
+}
+inline Real sinh(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::sinh((Real::PrimitiveReal)x);
+}
+inline Real sqrt(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::sqrt((Real::PrimitiveReal)x);
+}
+inline Real tan(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::tan((Real::PrimitiveReal)x);
+}
+inline Real tanh(Real x) {
+  detail::countOperation(&OperationCounts::libm);
+  return std::tanh((Real::PrimitiveReal)x);
+}
+
+// Accuracy tiers for fast elementary functions on Real.
+//
+// A tier is chosen per call site as a template argument,
+// e.g. sin<Accuracy::Micro>(x). Plain sin(x) stays the libm one.
+enum class Accuracy {
+  // Delegate to libm on long double: slow, but exact to the last bit.
+  Libm,
+  // Absolute error about 1e-9 or better, evaluated in double.
+  Nano,
+  // Absolute error about 1e-6 or better, evaluated in double
+  // with shorter polynomials.
+  Micro,
+};
+
+namespace detail {
+
+// sin and cos at once, for |x| <= 1e6.
+//
+// The argument is reduced to r in [-pi/4, pi/4] with a three-part
+// Cody-Waite splitting of pi/2, then truncated Taylor series are
+// evaluated. The first omitted term bounds the error:
+// 7e-12 (Nano) and 3e-7 (Micro).
+//
+// The body is branch-free so that loops over arrays of doubles
+// are vectorized by the compiler. The quadrant is read from
+// the bits of the rounded multiple of pi/2 instead of
+// converting it to an integer, which is undefined for NaN,
+// infinities and huge arguments; non-finite x gives NaN,
+// as with libm.
+template <Accuracy A>
+inline void fastSinCos(double x, double &s, double &c) {
+  constexpr double twoOverPi = 0.63661977236758134308;
+  constexpr double pio2Hi = 1.57079632673412561417e+00;
+  constexpr double pio2Mid = 6.07710050630396597660e-11;
+  constexpr double pio2Lo = 2.02226624879595063154e-21;
+  constexpr double rounder = 0x1.8p52;
+  double shifted = x * twoOverPi + rounder;
+  double k = shifted - rounder;
+  double r = ((x - k * pio2Hi) - k * pio2Mid) - k * pio2Lo;
+  double r2 = r * r;
+  double sr, cr;
+  if constexpr (A == Accuracy::Nano) {
+    sr = -1.0 / 6 +
+         r2 * (1.0 / 120 +
+               r2 * (-1.0 / 5040 + r2 * (1.0 / 362880 - r2 / 39916800)));
+    cr = -1.0 / 2 +
+         r2 * (1.0 / 24 +
+               r2 * (-1.0 / 720 +
+                     r2 * (1.0 / 40320 +
+                           r2 * (-1.0 / 3628800 + r2 / 479001600))));
+  } else {
+    sr = -1.0 / 6 + r2 * (1.0 / 120 - r2 / 5040);
+    cr = -1.0 / 2 + r2 * (1.0 / 24 + r2 * (-1.0 / 720 + r2 / 40320));
+  }
+  sr = r + r * r2 * sr;
+  cr = 1 + r2 * cr;
+  // The low bits of shifted hold k modulo 2^51.
+  uint64_t q;
+  std::memcpy(&q, &shifted, sizeof(q));
+  double sw = (q & 1) ? cr : sr;
+  double cw = (q & 1) ? sr : cr;
+  s = (q & 2) ? -sw : sw;
+  c = ((q + 1) & 2) ? -cw : cw;
+}
+
+// atan(t) for t in [0, 1].
+//
+// Arguments above tan(pi/8) are mapped by
+// atan(t) = pi/4 + atan((t - 1) / (t + 1)) into [-tan(pi/8), tan(pi/8)],
+// where the truncated Taylor series has error below
+// 7e-11 (Nano) and 2e-8 (Micro).
+template <Accuracy A>
+inline double fastAtanUnit(double t) {
+  constexpr double tanPiOver8 = 0.41421356237309504880;
+  constexpr double piOver4 = 0.78539816339744830962;
+  bool big = t > tanPiOver8;
+  double u = big ? (t - 1) / (t + 1) : t;
+  double u2 = u * u;
+  double p;
+  if constexpr (A == Accuracy::Nano) {
+    p = 1.0 / 19 - u2 / 21;
+    p = 1.0 / 17 - u2 * p;
+    p = 1.0 / 15 - u2 * p;
+  } else {
+    p = 1.0 / 15;
+  }
+  p = 1.0 / 13 - u2 * p;
+  p = 1.0 / 11 - u2 * p;
+  p = 1.0 / 9 - u2 * p;
+  p = 1.0 / 7 - u2 * p;
+  p = 1.0 / 5 - u2 * p;
+  p = 1.0 / 3 - u2 * p;
+  p = u - u * u2 * p;
+  return big ? piOver4 + p : p;
+}
+
+// atan2(y, x) on top of fastAtanUnit, branch-free.
+template <Accuracy A>
+inline double fastAtan2(double y, double x) {
+  constexpr double pi = 3.14159265358979323846;
+  double ax = std::fabs(x), ay = std::fabs(y);
+  double hi = ax > ay ? ax : ay;
+  double lo = ax > ay ? ay : ax;
+  double a = fastAtanUnit<A>(hi == 0 ? 0 : lo / hi);
+  a = ay > ax ? pi / 2 - a : a;
+  a = std::signbit(x) ? pi - a : a;
+  return std::signbit(y) ? -a : a;
+}
+
+} // namespace detail
+
+// Elementary functions with a selectable accuracy tier.
+//
+// Nano and Micro tiers evaluate in double and expect
+// |x| <= 1e6 for sin, cos and sincos.
+template <Accuracy A>
+inline void sincos(Real x, Real &s, Real &c) {
+  if constexpr (A == Accuracy::Libm) {
+    s = sin(x);
+    c = cos(x);
+  } else {
+    double ds, dc;
+    detail::fastSinCos<A>(static_cast<double>(x), ds, dc);
+    s = ds;
+    c = dc;
+  }
+}
+template <Accuracy A>
+inline Real sin(Real x) {
+  Real s, c;
+  sincos<A>(x, s, c);
+  return s;
+}
+template <Accuracy A>
+inline Real cos(Real x) {
+  Real s, c;
+  sincos<A>(x, s, c);
+  return c;
+}
+template <Accuracy A>
+inline Real atan2(Real y, Real x) {
+  if constexpr (A == Accuracy::Libm)
+    return atan2(y, x);
+  else
+    return detail::fastAtan2<A>(static_cast<double>(y), static_cast<double>(x));
+}
+
+namespace detail {
+
+// Whether x is zero or a positive normal number of F,
+// so that it converts to F without overflow or underflow.
+template <typename F>
+inline bool inNormalRange(Real::PrimitiveReal x) {
+  return x == 0 || (x >= std::numeric_limits<F>::min() &&
+                    x <= std::numeric_limits<F>::max());
+}
+
+} // namespace detail
+
+// Square root with a selectable accuracy tier.
+//
+// Nano evaluates in double and Micro in float;
+// their errors are relative: about 1e-16 and 1e-7.
+// Arguments outside the normal range of that type,
+// negative ones included, go to the next more
+// accurate tier instead.
+template <Accuracy A>
+inline Real sqrt(Real x) {
+  auto value = static_cast<Real::PrimitiveReal>(x);
+  if constexpr (A == Accuracy::Libm) {
+    return sqrt(x);
+  } else if constexpr (A == Accuracy::Nano) {
+    if (detail::inNormalRange<double>(value))
+      return std::sqrt(static_cast<double>(value));
+    return sqrt(x);
+  } else {
+    if (detail::inNormalRange<float>(value))
+      return std::sqrt(static_cast<float>(value));
+    return sqrt<Accuracy::Nano>(x);
+  }
+}
+
+// Batch forms over arrays of Real or double:
+// s[i] = sin(x[i]), c[i] = cos(x[i]) for i = 0, ..., n - 1.
+//
+// On double arrays the Nano and Micro loops are vectorized.
+template <Accuracy A, typename F>
+void sincos(const F *x, F *s, F *c, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    if constexpr (A == Accuracy::Libm) {
+      using std::cos, std::sin;
+      s[i] = sin(x[i]);
+      c[i] = cos(x[i]);
+    } else {
+      double ds, dc;
+      detail::fastSinCos<A>(static_cast<double>(x[i]), ds, dc);
+      s[i] = ds;
+      c[i] = dc;
+    }
+  }
+}
+
+// Batch form of atan2: result[i] = atan2(y[i], x[i]).
+template <Accuracy A, typename F>
+void atan2(const F *y, const F *x, F *result, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    if constexpr (A == Accuracy::Libm) {
+      using std::atan2;
+      result[i] = atan2(y[i], x[i]);
+    } else {
+      result[i] = detail::fastAtan2<A>(static_cast<double>(y[i]),
+                                       static_cast<double>(x[i]));
+    }
+  }
+}
+
+namespace detail {
+
+// The primitive type of the elements of comparison kernels.
+template <typename F>
+using ComparedType = std::conditional_t<std::is_same<F, Real>::value,
+                                        Real::PrimitiveReal, F>;
+
+// Elements per block of comparison kernels: inner loops
+// with a fixed trip count are vectorized even at -O2.
+constexpr size_t compareBlock = 32;
+
+// mask[i] = x[i] C rhs(i) for i = 0, ..., n - 1.
+template <Comparison C, typename F, typename Rhs>
+inline void compareArray(const F *__restrict x, Rhs rhs,
+                         uint8_t *__restrict mask, size_t n) {
+  using P = ComparedType<F>;
+  constexpr P eps = static_cast<P>(Real::eps);
+  const size_t blocked = n - n % compareBlock;
+  for (size_t i = 0; i < blocked; i += compareBlock)
+    for (size_t j = i; j < i + compareBlock; ++j)
+      mask[j] = epsilonCompare<C>(static_cast<P>(x[j]), rhs(j), eps);
+  for (size_t i = blocked; i < n; ++i)
+    mask[i] = epsilonCompare<C>(static_cast<P>(x[i]), rhs(i), eps);
+}
+
+} // namespace detail
+
+// Batch epsilon comparisons over arrays of Real or double:
+// mask[i] = x[i] C y[i] for i = 0, ..., n - 1,
+// with the same results as the operators of Real.
+//
+// On double arrays the tolerance is Real::eps rounded
+// to double, and the loops are vectorized when compiled
+// for SSE4.1 or later, e.g. with -march=x86-64-v2.
+// mask must not overlap the inputs.
+template <Comparison C, typename F>
+void compare(const F *x, const F *y, uint8_t *mask, size_t n) {
+  using P = detail::ComparedType<F>;
+  const F *__restrict right = y;
+  detail::compareArray<C>(
+      x, [right](size_t i) { return static_cast<P>(right[i]); }, mask, n);
+}
+
+// The same against a single value: mask[i] = x[i] C y.
+template <Comparison C, typename F>
+void compare(const F *x, F y, uint8_t *mask, size_t n) {
+  const auto value = static_cast<detail::ComparedType<F>>(y);
+  detail::compareArray<C>(x, [value](size_t) { return value; }, mask, n);
+}
 
 // The sign of a number:
 // a value in {-1, 0, +1}.
@@ -161,108 +632,142 @@ template <typename T>
 class Vector {
 public:
   // Default constructor: zero vector.
-  Vector() : coords{0, 0} {}
+  constexpr Vector() : coords{0, 0} {}
 
   // Construct vector by coordinates.
   template <typename P, typename Q = P>
-  Vector(P x, Q y) : coords{static_cast<T>(x), static_cast<T>(y)} {}
+  constexpr Vector(P x, Q y) : coords{static_cast<T>(x), static_cast<T>(y)} {}
 
   // Conversion between vectors with different coordinate types.
   template <typename P>
-  Vector(Vector<P> v) : coords{static_cast<T>(v.x()), static_cast<T>(v.y())} {}
+  constexpr Vector(Vector<P> v)
+      : coords{static_cast<T>(v.x()), static_cast<T>(v.y())} {}
 
   // Construct vector by two endpoints.
-  explicit Vector(Point<T> A, Point<T> B)
+  constexpr explicit Vector(Point<T> A, Point<T> B)
       : coords{B.x() - A.x(), B.y() - A.y()} {}
 
   // Access to x and y coordinates.
-  T &x() { return coords[0]; }
-  T x() const { return coords[0]; }
-  T &y() { return coords[1]; }
-  T y() const { return coords[1]; }
+  constexpr T &x() { return coords[0]; }
+  constexpr T x() const { return coords[0]; }
+  constexpr T &y() { return coords[1]; }
+  constexpr T y() const { return coords[1]; }
 
   // Access to coordinates by [] operator.
-  T &operator[](int i) { return coords[i]; }
-  T operator[](int i) const { return coords[i]; }
+  constexpr T &operator[](int i) { return coords[i]; }
+  constexpr T operator[](int i) const { return coords[i]; }
 
   // Comparison operators.
-  bool operator==(Vector<T> other) const { return coords == other.coords; }
-  bool operator!=(Vector<T> other) const { return coords != other.coords; }
-  bool operator<(Vector<T> other) const { return coords < other.coords; }
-  bool operator<=(Vector<T> other) const { return coords <= other.coords; }
-  bool operator>(Vector<T> other) const { return coords > other.coords; }
-  bool operator>=(Vector<T> other) const { return coords >= other.coords; }
+  //
+  // Lexicographic, spelled out coordinate-wise
+  // since std::array comparisons are not constexpr in C++17.
+  constexpr bool operator==(Vector<T> other) const {
+    detail::countOperation(&OperationCounts::vector);
+    return x() == other.x() && y() == other.y();
+  }
+  constexpr bool operator!=(Vector<T> other) const {
+    return !(*this == other);
+  }
+  constexpr bool operator<(Vector<T> other) const {
+    detail::countOperation(&OperationCounts::vector);
+    return x() < other.x() || (!(other.x() < x()) && y() < other.y());
+  }
+  constexpr bool operator<=(Vector<T> other) const { return !(other < *this); }
+  constexpr bool operator>(Vector<T> other) const { return other < *this; }
+  constexpr bool operator>=(Vector<T> other) const { return !(*this < other); }
 
   // Vector addition operators.
-  Vector<T> operator+(Vector<T> other) const {
+  constexpr Vector<T> operator+(Vector<T> other) const {
+    detail::countOperation(&OperationCounts::vector);
     return {x() + other.x(), y() + other.y()};
   }
-  Vector<T> &operator+=(Vector<T> other) {
+  constexpr Vector<T> &operator+=(Vector<T> other) {
+    detail::countOperation(&OperationCounts::vector);
     x() += other.x();
     y() += other.y();
     return *this;
   }
-  Vector<T> operator+() const { return *this; }
-  Vector<T> operator-(Vector<T> other) const {
+  constexpr Vector<T> operator+() const { return *this; }
+  constexpr Vector<T> operator-(Vector<T> other) const {
+    detail::countOperation(&OperationCounts::vector);
     return {x() - other.x(), y() - other.y()};
   }
-  Vector<T> &operator-=(Vector<T> other) {
+  constexpr Vector<T> &operator-=(Vector<T> other) {
+    detail::countOperation(&OperationCounts::vector);
     x() -= other.x();
     y() -= other.y();
     return *this;
   }
-  Vector<T> operator-() const { return {-x(), -y()}; }
+  constexpr Vector<T> operator-() const {
+    detail::countOperation(&OperationCounts::vector);
+    return {-x(), -y()};
+  }
 
   // Scalar multiplication operators.
-  Vector<T> operator*(T rhs) const { return {x() * rhs, y() * rhs}; }
-  friend Vector<T> operator*(T lhs, Vector<T> rhs) { return rhs * lhs; }
-  Vector<T> &operator*=(T k) {
+  constexpr Vector<T> operator*(T rhs) const {
+    detail::countOperation(&OperationCounts::vector);
+    return {x() * rhs, y() * rhs};
+  }
+  constexpr friend Vector<T> operator*(T lhs, Vector<T> rhs) {
+    return rhs * lhs;
+  }
+  constexpr Vector<T> &operator*=(T k) {
+    detail::countOperation(&OperationCounts::vector);
     x() *= k;
     y() *= k;
     return *this;
   }
-  Vector<T> operator/(T rhs) const { return {x() / rhs, y() / rhs}; }
-  Vector<T> &operator/=(T rhs) {
+  constexpr Vector<T> operator/(T rhs) const {
+    detail::countOperation(&OperationCounts::vector);
+    return {x() / rhs, y() / rhs};
+  }
+  constexpr Vector<T> &operator/=(T rhs) {
+    detail::countOperation(&OperationCounts::vector);
     x() /= rhs;
     y() /= rhs;
     return *this;
   }
 
   // Dot product.
-  T operator^(Vector<T> other) const {
+  constexpr T operator^(Vector<T> other) const {
+    detail::countOperation(&OperationCounts::vector);
     return x() * other.x() + y() * other.y();
   }
 
   // Returns true iff vectors are perpendicular.
-  bool perpendicularTo(Vector<T> other) { return (*this ^ other) == 0; }
+  constexpr bool perpendicularTo(Vector<T> other) {
+    return (*this ^ other) == 0;
+  }
 
   // Cross product.
-  T operator%(Vector<T> other) const {
+  constexpr T operator%(Vector<T> other) const {
+    detail::countOperation(&OperationCounts::vector);
     return x() * other.y() - y() * other.x();
   }
 
   // Returns true iff vectors are parallel.
-  bool parallelTo(Vector<T> other) const { return *this % other == 0; }
+  constexpr bool parallelTo(Vector<T> other) const {
+    return *this % other == 0;
+  }
 
   // Squared length of the vector.
-  T len2() const { return x() * x() + y() * y(); }
+  constexpr T len2() const {
+    detail::countOperation(&OperationCounts::vector);
+    return x() * x() + y() * y();
+  }
 
   // Length of the vector.
   Real len() const { return sqrt(len2()); }
 
   // Simple rotations.
-  Vector<T> &rotateCounterclockwise() {
-    std::swap(x(), y());
-    x() *= -1;
-    return *this;
+  constexpr Vector<T> &rotateCounterclockwise() {
+    return *this = rotatedCounterclockwise();
   }
-  Vector<T> rotatedCounterclockwise() const { return {-y(), x()}; }
-  Vector<T> &rotateClockwise() {
-    std::swap(x(), y());
-    y() *= -1;
-    return *this;
+  constexpr Vector<T> rotatedCounterclockwise() const { return {-y(), x()}; }
+  constexpr Vector<T> &rotateClockwise() {
+    return *this = rotatedClockwise();
   }
-  Vector<T> rotatedClockwise() const { return {y(), -x()}; }
+  constexpr Vector<T> rotatedClockwise() const { return {y(), -x()}; }
 
   // I/O stream operators.
   //
@@ -279,10 +784,10 @@ public:
   // Iterator methods for range-based for loops over Vector.
   //
   // They are delegated to iterators over coords array.
-  auto begin() { return coords.begin(); }
-  auto begin() const { return coords.begin(); }
-  auto end() { return coords.end(); }
-  auto end() const { return coords.end(); }
+  constexpr auto begin() { return coords.begin(); }
+  constexpr auto begin() const { return coords.begin(); }
+  constexpr auto end() { return coords.end(); }
+  constexpr auto end() const { return coords.end(); }
 
 private:
   std::array<T, 2> coords;
@@ -290,7 +795,7 @@ private:
 
 // Squared euclidean distance between two points.
 template <typename T>
-T dist2(Point<T> A, Point<T> B) {
+constexpr T dist2(Point<T> A, Point<T> B) {
   return (B - A).len2();
 }
 
@@ -317,6 +822,14 @@ inline RVector normalized(RVector v) { return v / v.len(); }
 using LVector = Vector<int64_t>;
 using LPoint = LVector;
 
+// Compact integral vectors: 2 and 4 times as many points
+// per cache line as LVector. Products of their coordinates
+// overflow the coordinate type, see wideCross and wideDot.
+using IVector = Vector<int32_t>;
+using IPoint = IVector;
+using SVector = Vector<int16_t>;
+using SPoint = SVector;
+
 // Scales an integral vector down so it's coordinates
 // are coprime.
 //
@@ -324,7 +837,8 @@ using LPoint = LVector;
 // where the first non-null coordinate is positive
 // is returned.
 template <typename T>
-typename std::enable_if_t<std::is_integral<T>::value> normalize(Vector<T> &v) {
+constexpr typename std::enable_if_t<std::is_integral<T>::value>
+normalize(Vector<T> &v) {
   auto g = std::gcd(v.x(), v.y());
   if (!g)
     return;
@@ -334,12 +848,106 @@ typename std::enable_if_t<std::is_integral<T>::value> normalize(Vector<T> &v) {
   v.y() /= g;
 }
 template <typename T>
-typename std::enable_if_t<std::is_integral<T>::value, Vector<T>>
+constexpr typename std::enable_if_t<std::is_integral<T>::value, Vector<T>>
 normalized(Vector<T> v) {
   normalize(v);
   return v;
 }
 
+// An integral type holding sums of two products
+// of T values exactly: two products of 32-bit values
+// reach 2^63, so only types of 16 bits fit in int64_t.
+template <typename T>
+using WideProduct = std::conditional_t<sizeof(T) <= 2, int64_t, __int128>;
+
+// Cross and dot products and squared length of integral vectors,
+// computed exactly in a wider type.
+template <typename T>
+constexpr WideProduct<T> wideCross(Vector<T> a, Vector<T> b) {
+  using W = WideProduct<T>;
+  return W(a.x()) * b.y() - W(a.y()) * b.x();
+}
+template <typename T>
+constexpr WideProduct<T> wideDot(Vector<T> a, Vector<T> b) {
+  using W = WideProduct<T>;
+  return W(a.x()) * b.x() + W(a.y()) * b.y();
+}
+template <typename T>
+constexpr WideProduct<T> wideLen2(Vector<T> a) {
+  return wideDot(a, a);
+}
+
+// Maps real points onto a square grid with integral
+// coordinates of type T and back.
+//
+// Grid coordinates are bounded by half the maximum of T
+// in absolute value, so that differences of quantized points
+// are representable in T as well; points farther away
+// from the center are clamped to the grid, and NaN
+// coordinates are mapped to the center.
+template <typename T>
+class Quantizer {
+  static_assert(std::is_integral<T>::value && std::is_signed<T>::value);
+
+public:
+  // The largest grid coordinate in absolute value.
+  static constexpr T limit = std::numeric_limits<T>::max() / 2;
+
+  // The grid with origin at center and the given step.
+  Quantizer(RPoint center, Real step)
+      : originX(static_cast<Real::PrimitiveReal>(center.x())),
+        originY(static_cast<Real::PrimitiveReal>(center.y())),
+        gridStep(static_cast<Real::PrimitiveReal>(step)),
+        inverseStep(1 / gridStep) {}
+
+  // The finest grid covering the box [lo, hi].
+  static Quantizer fit(RPoint lo, RPoint hi) {
+    // In primitive reals: steps can be below Real::eps.
+    auto extent = static_cast<Real::PrimitiveReal>(
+        std::max(hi.x() - lo.x(), hi.y() - lo.y()));
+    auto step = extent / (2 * static_cast<Real::PrimitiveReal>(limit));
+    return Quantizer((lo + hi) / 2, step > 0 ? step : 1);
+  }
+
+  // The distance between neighbouring grid points; a point
+  // inside the grid is quantized with an error of at most
+  // half the step in each coordinate.
+  Real step() const { return gridStep; }
+
+  // The nearest grid point.
+  Vector<T> quantize(RPoint P) const {
+    return {toGrid(static_cast<Real::PrimitiveReal>(P.x()) - originX),
+            toGrid(static_cast<Real::PrimitiveReal>(P.y()) - originY)};
+  }
+
+  // The real point of a grid point.
+  RPoint dequantize(Vector<T> Q) const {
+    return {originX + Q.x() * gridStep, originY + Q.y() * gridStep};
+  }
+
+  // Array forms: out[i] = quantize(points[i]), dequantize(points[i])
+  // for i = 0, ..., n - 1.
+  void quantize(const RPoint *points, Vector<T> *out, size_t n) const {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = quantize(points[i]);
+  }
+  void dequantize(const Vector<T> *points, RPoint *out, size_t n) const {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = dequantize(points[i]);
+  }
+
+private:
+  // NaN, which cannot be clamped, goes to the center.
+  T toGrid(Real::PrimitiveReal offset) const {
+    Real::PrimitiveReal q = std::nearbyint(offset * inverseStep);
+    if (std::isnan(q))
+      return 0;
+    return static_cast<T>(std::clamp<Real::PrimitiveReal>(q, -limit, limit));
+  }
+
+  Real::PrimitiveReal originX, originY, gridStep, inverseStep;
+};
+
 // Area of the triangle formed by two vectors.
 template <typename T>
 Real triangleArea(Vector<T> a, Vector<T> b) {
@@ -352,33 +960,50 @@ Real triangleArea(Point<T> A, Point<T> B, Point<T> C) {
   return triangleArea(Vector<T>(A, B), Vector<T>(A, C));
 }
 
+// Returns +1 if point D lies strictly inside the circle
+// through points A, B, C listed counterclockwise,
+// -1 if it lies outside and 0 if on the circle.
+//
+// The 3 x 3 determinant is computed in type W.
+// For integral coordinates below 2^29 in absolute value
+// __int128 is enough, for any int64_t coordinates
+// use a 320-bit integer, e.g. acmlib::numeric::BigInt<5>.
+template <typename W, typename T>
+int32_t inCircle(Point<T> A, Point<T> B, Point<T> C, Point<T> D) {
+  W ax = W(A.x()) - W(D.x()), ay = W(A.y()) - W(D.y());
+  W bx = W(B.x()) - W(D.x()), by = W(B.y()) - W(D.y());
+  W cx = W(C.x()) - W(D.x()), cy = W(C.y()) - W(D.y());
+  W a = ax * ax + ay * ay, b = bx * bx + by * by, c = cx * cx + cy * cy;
+  return sign(a * (bx * cy - by * cx) - b * (ax * cy - ay * cx) +
+              c * (ax * by - ay * bx));
+}
+
 // A 2 x 2 matrix of numbers with type T.
 template <typename T>
 class Matrix {
   std::array<std::array<T, 2>, 2> entries;
 
 public:
-  Matrix() = default;
+  // Default constructor: zero matrix.
+  constexpr Matrix() : entries{} {}
 
-  Matrix(T a, T b, T c, T d) : entries{{a, b}, {c, d}} {}
+  constexpr Matrix(T a, T b, T c, T d) : entries{{{a, b}, {c, d}}} {}
 
   template <typename P>
-  Matrix(Matrix<P> other) {
-    for (int i = 0; i < 2; ++i)
-      for (int j = 0; j < 2; ++j)
-        entries[i][j] = static_cast<T>(other.entries[i][j]);
-  }
-
-  T a() const { return entries[0][0]; }
-  T &a() { return entries[0][0]; }
-  T b() const { return entries[0][1]; }
-  T &b() { return entries[0][1]; }
-  T c() const { return entries[1][0]; }
-  T &c() { return entries[1][0]; }
-  T d() const { return entries[1][1]; }
-  T &d() { return entries[1][1]; }
-
-  Matrix<T> &operator+=(Matrix<T> other) {
+  constexpr Matrix(Matrix<P> other)
+      : entries{{{static_cast<T>(other.a()), static_cast<T>(other.b())},
+                 {static_cast<T>(other.c()), static_cast<T>(other.d())}}} {}
+
+  constexpr T a() const { return entries[0][0]; }
+  constexpr T &a() { return entries[0][0]; }
+  constexpr T b() const { return entries[0][1]; }
+  constexpr T &b() { return entries[0][1]; }
+  constexpr T c() const { return entries[1][0]; }
+  constexpr T &c() { return entries[1][0]; }
+  constexpr T d() const { return entries[1][1]; }
+  constexpr T &d() { return entries[1][1]; }
+
+  constexpr Matrix<T> &operator+=(Matrix<T> other) {
     for (int i = 0; i < 2; ++i) {
       for (int j = 0; j < 2; ++j) {
         entries[i][j] += other.entries[i][j];
@@ -386,11 +1011,11 @@ public:
     }
     return *this;
   }
-  Matrix<T> operator+(Matrix<T> other) const {
+  constexpr Matrix<T> operator+(Matrix<T> other) const {
     return Matrix<T>(*this) += other;
   }
-  Matrix<T> operator+() const { return *this; }
-  Matrix<T> &operator-=(Matrix<T> other) {
+  constexpr Matrix<T> operator+() const { return *this; }
+  constexpr Matrix<T> &operator-=(Matrix<T> other) {
     for (int i = 0; i < 2; ++i) {
       for (int j = 0; j < 2; ++j) {
         entries[i][j] -= other.entries[i][j];
@@ -398,12 +1023,12 @@ public:
     }
     return *this;
   }
-  Matrix<T> operator-(Matrix<T> other) const {
+  constexpr Matrix<T> operator-(Matrix<T> other) const {
     return Matrix<T>(*this) -= other;
   }
-  Matrix<T> operator-() const { return *this * (-1); }
+  constexpr Matrix<T> operator-() const { return *this * (-1); }
 
-  Matrix<T> &operator*=(T rhs) {
+  constexpr Matrix<T> &operator*=(T rhs) {
     for (int i = 0; i < 2; ++i) {
       for (int j = 0; j < 2; ++j) {
         entries[i][j] *= rhs;
@@ -411,9 +1036,13 @@ public:
     }
     return *this;
   }
-  Matrix<T> operator*(T rhs) const { return Matrix<T>(*this) *= rhs; }
-  friend Matrix<T> operator*(T lhs, Matrix<T> rhs) { return rhs * lhs; }
-  Matrix<T> &operator/=(T rhs) {
+  constexpr Matrix<T> operator*(T rhs) const {
+    return Matrix<T>(*this) *= rhs;
+  }
+  constexpr friend Matrix<T> operator*(T lhs, Matrix<T> rhs) {
+    return rhs * lhs;
+  }
+  constexpr Matrix<T> &operator/=(T rhs) {
     for (int i = 0; i < 2; ++i) {
       for (int j = 0; j < 2; ++j) {
         entries[i][j] /= rhs;
@@ -421,28 +1050,242 @@ public:
     }
     return *this;
   }
-  Matrix<T> operator/(T rhs) { return Matrix<T>(*this) /= rhs; }
+  constexpr Matrix<T> operator/(T rhs) const {
+    return Matrix<T>(*this) /= rhs;
+  }
 
-  Matrix<T> operator*(Matrix<T> other) const {
-    Matrix<T> result;
-    for (int i = 0; i < 2; ++i)
-      for (int j = 0; j < 2; ++j)
-        for (int r = 0; r < 2; ++r)
-          result[i][j] += (*this)[i][r] * other[r][j];
-    return result;
+  // Matrix product, unrolled.
+  constexpr Matrix<T> operator*(Matrix<T> other) const {
+    return {a() * other.a() + b() * other.c(),
+            a() * other.b() + b() * other.d(),
+            c() * other.a() + d() * other.c(),
+            c() * other.b() + d() * other.d()};
   }
-  Matrix<T> &operator*=(Matrix<T> other) { *this = *this * other; }
-  Vector<T> operator*(Vector<T> rhs) const {
+  constexpr Matrix<T> &operator*=(Matrix<T> other) {
+    return *this = *this * other;
+  }
+  constexpr Vector<T> operator*(Vector<T> rhs) const {
     return {a() * rhs.x() + b() * rhs.y(), c() * rhs.x() + d() * rhs.y()};
   }
-  friend Vector<T> operator*(Vector<T> lhs, Matrix<T> rhs) {
+  constexpr friend Vector<T> operator*(Vector<T> lhs, Matrix<T> rhs) {
     return {lhs.x() * rhs.a() + lhs.y() * rhs.c(),
             lhs.x() * rhs.b() + lhs.y() * rhs.d()};
   }
 
-  T det() const { return a() * d() - b() * c(); }
+  constexpr T det() const { return a() * d() - b() * c(); }
+
+  // The identity matrix.
+  static constexpr Matrix<T> identity() { return {1, 0, 0, 1}; }
+
+  // Entry-wise comparison.
+  constexpr bool operator==(Matrix<T> other) const {
+    return a() == other.a() && b() == other.b() && c() == other.c() &&
+           d() == other.d();
+  }
+  constexpr bool operator!=(Matrix<T> other) const {
+    return !(*this == other);
+  }
+
+  // I/O stream operators.
+  //
+  // In the stream a matrix is represented by
+  // four space-separated entries a, b, c, d
+  // in row-major order.
+  friend std::istream &operator>>(std::istream &is, Matrix<T> &m) {
+    return is >> m.a() >> m.b() >> m.c() >> m.d();
+  }
+  friend std::ostream &operator<<(std::ostream &os, Matrix<T> m) {
+    return os << m.a() << ' ' << m.b() << ' ' << m.c() << ' ' << m.d();
+  }
 };
 
+// Matrix m raised to a non-negative integer power k
+// by binary exponentiation in O(log k) multiplications.
+template <typename T>
+constexpr Matrix<T> pow(Matrix<T> m, uint64_t k) {
+  Matrix<T> result = Matrix<T>::identity();
+  while (k) {
+    if (k & 1)
+      result *= m;
+    // No squaring past the highest bit, which could overflow.
+    if (k >>= 1)
+      m *= m;
+  }
+  return result;
+}
+
+namespace detail {
+
+// Entry-wise remainder in [0, mod).
+template <typename T>
+constexpr Matrix<T> reduceMod(Matrix<T> m, T mod) {
+  auto reduce = [mod](T x) {
+    T r = x % mod;
+    if constexpr (std::is_signed<T>::value)
+      if (r < 0)
+        r += mod;
+    return r;
+  };
+  return {reduce(m.a()), reduce(m.b()), reduce(m.c()), reduce(m.d())};
+}
+
+// mulMod of matrices with entries already in [0, mod).
+template <typename T>
+constexpr Matrix<T> mulModReduced(Matrix<T> lhs, Matrix<T> rhs, T mod) {
+  auto dot = [mod](T x1, T y1, T x2, T y2) {
+    using Wide = unsigned __int128;
+    Wide sum = Wide(x1) * Wide(y1) % mod + Wide(x2) * Wide(y2) % mod;
+    return static_cast<T>(sum % mod);
+  };
+  return {dot(lhs.a(), rhs.a(), lhs.b(), rhs.c()),
+          dot(lhs.a(), rhs.b(), lhs.b(), rhs.d()),
+          dot(lhs.c(), rhs.a(), lhs.d(), rhs.c()),
+          dot(lhs.c(), rhs.b(), lhs.d(), rhs.d())};
+}
+
+} // namespace detail
+
+// Product of integral matrices modulo mod > 0,
+// with entries in [0, mod).
+//
+// Entries are reduced first, negative ones included.
+// Intermediate products are computed in 128 bits,
+// so any mod up to 2^63 is allowed.
+template <typename T>
+constexpr typename std::enable_if_t<std::is_integral<T>::value, Matrix<T>>
+mulMod(Matrix<T> lhs, Matrix<T> rhs, T mod) {
+  return detail::mulModReduced(detail::reduceMod(lhs, mod),
+                               detail::reduceMod(rhs, mod), mod);
+}
+
+// Integral matrix m raised to a power k modulo mod > 0
+// in O(log k) multiplications, with entries in [0, mod).
+//
+// Entries of m are reduced first, negative ones included.
+template <typename T>
+constexpr typename std::enable_if_t<std::is_integral<T>::value, Matrix<T>>
+powMod(Matrix<T> m, uint64_t k, T mod) {
+  m = detail::reduceMod(m, mod);
+  Matrix<T> result{1 % mod, 0, 0, 1 % mod};
+  while (k) {
+    if (k & 1)
+      result = detail::mulModReduced(result, m, mod);
+    if (k >>= 1)
+      m = detail::mulModReduced(m, m, mod);
+  }
+  return result;
+}
+
+// Batched matrix product: out[i] = lhs[i] * rhs[i]
+// for i = 0, ..., n - 1.
+//
+// The loop body is branch-free and has no dependencies
+// between iterations, so it is vectorized by the compiler.
+// out may coincide with lhs or rhs.
+template <typename T>
+void multiplyBatch(const Matrix<T> *lhs, const Matrix<T> *rhs, Matrix<T> *out,
+                   size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    out[i] = lhs[i] * rhs[i];
+}
+
+// Product of a chain of matrices: m[0] * m[1] * ... * m[n - 1].
+//
+// Pairs are multiplied level by level so that
+// multiplications inside a level are independent
+// and can overlap in the pipeline.
+// The buffer is used as scratch space and is overwritten.
+template <typename T>
+Matrix<T> chainProduct(Matrix<T> *m, size_t n) {
+  if (n == 0)
+    return Matrix<T>::identity();
+  while (n > 1) {
+    size_t half = n / 2;
+    for (size_t i = 0; i < half; ++i)
+      m[i] = m[2 * i] * m[2 * i + 1];
+    if (n & 1)
+      m[half] = m[n - 1];
+    n = half + (n & 1);
+  }
+  return m[0];
+}
+
+namespace detail {
+
+constexpr long double pi = 3.141592653589793238462643383279502884l;
+
+// sin(x) for x in [-pi/2, pi/2] by its Taylor series.
+//
+// Terms are added until they stop changing the sum,
+// which gives full long double precision on this range.
+constexpr long double constexprSinReduced(long double x) {
+  long double term = x, sum = x;
+  for (int n = 1; n < 40 && sum + term != sum; ++n) {
+    term *= -x * x / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+// sin(x) usable in constant expressions.
+constexpr long double constexprSin(long double x) {
+  long double turns = x / (2 * pi);
+  long long k = static_cast<long long>(turns < 0 ? turns - 0.5l : turns + 0.5l);
+  x -= k * (2 * pi);
+  if (x > pi / 2)
+    x = pi - x;
+  else if (x < -pi / 2)
+    x = -pi - x;
+  return constexprSinReduced(x);
+}
+
+// cos(x) usable in constant expressions.
+constexpr long double constexprCos(long double x) {
+  return constexprSin(x + pi / 2);
+}
+
+} // namespace detail
+
+// Unit vectors pointing in N directions evenly
+// spread counterclockwise, starting from (1, 0).
+//
+// Computed at compile time when used to initialize
+// a constexpr variable.
+template <size_t N, typename T = Real>
+constexpr std::array<Vector<T>, N> unitDirections() {
+  std::array<Vector<T>, N> result{};
+  for (size_t k = 0; k < N; ++k) {
+    long double angle = 2 * detail::pi * k / N;
+    result[k] = {detail::constexprCos(angle), detail::constexprSin(angle)};
+  }
+  return result;
+}
+
+// Matrices of counterclockwise rotations
+// by angles 2 * pi * k / N, k = 0, ..., N - 1.
+//
+// Computed at compile time when used to initialize
+// a constexpr variable.
+template <size_t N, typename T = Real>
+constexpr std::array<Matrix<T>, N> rotationMatrices() {
+  std::array<Matrix<T>, N> result{};
+  for (size_t k = 0; k < N; ++k) {
+    long double angle = 2 * detail::pi * k / N;
+    T c = detail::constexprCos(angle);
+    T s = detail::constexprSin(angle);
+    result[k] = {c, -s, s, c};
+  }
+  return result;
+}
+
+// Grid stencils: offsets to 4 side-adjacent
+// and 8 side- or corner-adjacent cells,
+// listed counterclockwise starting from (1, 0).
+inline constexpr std::array<LVector, 4> stencil4{
+    {{1, 0}, {0, 1}, {-1, 0}, {0, -1}}};
+inline constexpr std::array<LVector, 8> stencil8{
+    {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}}};
+
 // A line formed by equation ax + by = c.
 //
 // We assume that in all initialized Line objects
@@ -457,32 +1300,39 @@ class Line {
 public:
   // Evaluate left-hand side ax + by
   // on a given Point.
-  T eval(Point<T> P) const { return normal ^ P; }
+  constexpr T eval(Point<T> P) const { return normal ^ P; }
 
-  Line() = default;
+  // Default constructor: all coefficients are zero.
+  constexpr Line() : normal(), constant() {}
 
   // Construct a line given all coefficients.
-  Line(T a, T b, T c) : normal{a, b}, constant{c} {}
+  constexpr Line(T a, T b, T c) : normal{a, b}, constant{c} {}
 
   // Construct a line by two points.
-  Line(Point<T> A, Point<T> B)
+  constexpr Line(Point<T> A, Point<T> B)
       : normal{B.y() - A.y(), A.x() - B.x()}, constant{eval(A)} {}
 
+  // Conversion between lines with different coefficient types.
+  template <typename P>
+  constexpr explicit Line(Line<P> l)
+      : normal{static_cast<T>(l.a()), static_cast<T>(l.b())},
+        constant{static_cast<T>(l.c())} {}
+
   // Access to coefficients of the line equation.
-  T &a() { return normal.x(); }
-  T a() const { return normal.x(); }
-  T &b() { return normal.y(); }
-  T b() const { return normal.y(); }
-  T &c() { return constant; }
-  T c() const { return constant; }
+  constexpr T &a() { return normal.x(); }
+  constexpr T a() const { return normal.x(); }
+  constexpr T &b() { return normal.y(); }
+  constexpr T b() const { return normal.y(); }
+  constexpr T &c() { return constant; }
+  constexpr T c() const { return constant; }
 
   // Returns true iff the line contains given Point.
-  bool contains(Point<T> P) const { return eval(P) == constant; }
+  constexpr bool contains(Point<T> P) const { return eval(P) == constant; }
 
   // Returns +1 or -1 depending on which half-plane
   // the given point lies in, or 0 is the point
   // lies in the line.
-  int32_t relativePosition(Point<T> P) const {
+  constexpr int32_t relativePosition(Point<T> P) const {
     return sign(eval(P) - constant);
   }
 
@@ -502,9 +1352,33 @@ public:
   }
 
   // Returns true iff lines are parallel.
-  bool parallelTo(Line other) const { return normal.parallelTo(other.normal); }
+  constexpr bool parallelTo(Line other) const {
+    return normal.parallelTo(other.normal);
+  }
 };
 
+// Intersection point of two non-parallel lines.
+//
+// T must support division: with Real coordinates
+// the result is approximate, with rationals it is exact,
+// e.g. intersection(Line<XRational>(l), Line<XRational>(m))
+// for two LLines l, m.
+template <typename T>
+constexpr Point<T> intersection(Line<T> l, Line<T> m) {
+  T det = l.a() * m.b() - l.b() * m.a();
+  return {(l.c() * m.b() - l.b() * m.c()) / det,
+          (l.a() * m.c() - l.c() * m.a()) / det};
+}
+
+// Orthogonal projection of a point onto a line.
+//
+// T must support division, as in intersection.
+template <typename T>
+constexpr Point<T> projection(Line<T> l, Point<T> P) {
+  Vector<T> normal{l.a(), l.b()};
+  return P - normal * ((l.eval(P) - l.c()) / normal.len2());
+}
+
 // Type alias for lines with integral coefficients.
 using LLine = Line<int64_t>;
 // Type alias for lines with real coefficients.
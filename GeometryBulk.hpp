@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "Geometry.hpp"
+#include "Parallel.hpp"
+
+namespace acmlib {
+namespace geometry {
+
+// Bulk versions of Geometry.hpp operations over point arrays.
+//
+// The execution policy E is the first template argument,
+// e.g. transform<Execution::Parallel>(m, points, out, n).
+// Results do not depend on the policy nor on the number
+// of threads: reductions combine per-block partial results
+// in a fixed order, so even sums of reals are reproducible.
+using parallel::Execution;
+
+namespace detail {
+
+// Elements per block of bulk operations.
+constexpr size_t bulkGrain = 1 << 12;
+
+// Calls body(i) for i in [begin, end), hinting independence
+// of iterations to the vectorizer under ParallelSimd.
+template <Execution E, typename Body>
+inline void bulkLoop(size_t begin, size_t end, Body body) {
+  if constexpr (E == Execution::ParallelSimd) {
+#pragma GCC ivdep
+    for (size_t i = begin; i < end; ++i)
+      body(i);
+  } else {
+    for (size_t i = begin; i < end; ++i)
+      body(i);
+  }
+}
+
+// Calls body(i) for every i in [0, n) under the policy E.
+template <Execution E, typename Body>
+void bulkFor(size_t n, Body body) {
+  if constexpr (E == Execution::Sequential) {
+    bulkLoop<E>(0, n, body);
+  } else {
+    parallel::parallelFor(
+        0, n, [&](size_t begin, size_t end) { bulkLoop<E>(begin, end, body); },
+        bulkGrain);
+  }
+}
+
+// Reduces the blocks of [0, n) under the policy E,
+// see parallel::parallelReduce.
+template <Execution E, typename R, typename Block, typename Combine>
+R bulkReduce(size_t n, R init, Block block, Combine combine) {
+  if constexpr (E == Execution::Sequential) {
+    for (size_t begin = 0; begin < n; begin += bulkGrain)
+      init = combine(init, block(begin, std::min(n, begin + bulkGrain)));
+    return init;
+  } else {
+    return parallel::parallelReduce(0, n, init, block, combine, bulkGrain);
+  }
+}
+
+} // namespace detail
+
+// out[i] = m * points[i] for i = 0, ..., n - 1.
+// out may coincide with points unless E is ParallelSimd.
+template <Execution E = Execution::Sequential, typename T>
+void transform(Matrix<T> m, const Point<T> *points, Point<T> *out, size_t n) {
+  detail::bulkFor<E>(n, [&](size_t i) { out[i] = m * points[i]; });
+}
+
+// out[i] = dist2(query, points[i]) for i = 0, ..., n - 1.
+template <Execution E = Execution::Sequential, typename T>
+void dist2(Point<T> query, const Point<T> *points, T *out, size_t n) {
+  detail::bulkFor<E>(n, [&](size_t i) { out[i] = dist2(query, points[i]); });
+}
+
+// out[i] = l.relativePosition(points[i]) for i = 0, ..., n - 1.
+template <Execution E = Execution::Sequential, typename T>
+void classify(Line<T> l, const Point<T> *points, int32_t *out, size_t n) {
+  detail::bulkFor<E>(
+      n, [&](size_t i) { out[i] = l.relativePosition(points[i]); });
+}
+
+// The lower left and upper right corners
+// of the bounding box of n > 0 points.
+template <Execution E = Execution::Sequential, typename T>
+void boundingBox(const Point<T> *points, size_t n, Point<T> &lo,
+                 Point<T> &hi) {
+  struct Box {
+    Point<T> lo, hi;
+  };
+  auto merge = [](Box a, Box b) {
+    return Box{{std::min(a.lo.x(), b.lo.x()), std::min(a.lo.y(), b.lo.y())},
+               {std::max(a.hi.x(), b.hi.x()), std::max(a.hi.y(), b.hi.y())}};
+  };
+  Box box = detail::bulkReduce<E>(
+      n, Box{points[0], points[0]},
+      [&](size_t begin, size_t end) {
+        Box result{points[begin], points[begin]};
+        for (size_t i = begin + 1; i < end; ++i)
+          result = merge(result, Box{points[i], points[i]});
+        return result;
+      },
+      merge);
+  lo = box.lo;
+  hi = box.hi;
+}
+
+// Total area of the triangles A[i] B[i] C[i], i = 0, ..., n - 1.
+template <Execution E = Execution::Sequential, typename T>
+Real triangleAreaSum(const Point<T> *A, const Point<T> *B, const Point<T> *C,
+                     size_t n) {
+  return detail::bulkReduce<E>(
+      n, Real(0),
+      [&](size_t begin, size_t end) {
+        Real sum = 0;
+        for (size_t i = begin; i < end; ++i)
+          sum += triangleArea(A[i], B[i], C[i]);
+        return sum;
+      },
+      [](Real acc, Real partial) { return acc + partial; });
+}
+
+} // namespace geometry
+} // namespace acmlib
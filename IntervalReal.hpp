@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+
+namespace acmlib {
+namespace numeric {
+
+namespace detail {
+
+// Neighbouring doubles towards +infinity and -infinity.
+inline double nextUp(double x) {
+  if (std::isnan(x) || x == std::numeric_limits<double>::infinity())
+    return x;
+  if (x == 0)
+    return std::numeric_limits<double>::denorm_min();
+  uint64_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  bits += x > 0 ? 1 : -1;
+  std::memcpy(&x, &bits, sizeof(bits));
+  return x;
+}
+inline double nextDown(double x) { return -nextUp(-x); }
+
+// Error-free transformations: s + e is exactly a + b,
+// p + e is exactly a * b.
+//
+// Where this cannot hold, e is NaN and only |e| <= ulp / 2
+// is known: on overflow, for products below 2^-969 whose
+// error may underflow, and, without FMA, for factors above
+// 2^996 whose Veltkamp splitting overflows.
+inline void twoSum(double a, double b, double &s, double &e) {
+  s = a + b;
+  double bb = s - a;
+  e = (a - (s - bb)) + (b - bb);
+}
+inline void twoProduct(double a, double b, double &p, double &e) {
+  p = a * b;
+  if (std::fabs(p) < 0x1p-969 && a != 0 && b != 0) {
+    e = std::numeric_limits<double>::quiet_NaN();
+    return;
+  }
+#ifdef __FMA__
+  e = std::fma(a, b, -p);
+#else
+  // Veltkamp splitting into halves of 26 bits.
+  constexpr double splitter = 134217729.0;
+  double t = splitter * a, ah = t - (t - a), al = a - ah;
+  t = splitter * b;
+  double bh = t - (t - b), bl = b - bh;
+  e = ((ah * bh - p) + ah * bl + al * bh) + al * bl;
+#endif
+}
+
+// Rounds the exact value x + e, |e| <= ulp(x) / 2,
+// down and up to doubles.
+//
+// A non-finite e stands for an unknown error and widens
+// by an ulp on both sides; an infinite x means the exact
+// value lies beyond the largest double in its direction,
+// and NaN that it is unknown.
+inline void roundOutward(double x, double e, double &lo, double &hi) {
+  constexpr double infinity = std::numeric_limits<double>::infinity();
+  constexpr double largest = std::numeric_limits<double>::max();
+  if (!std::isfinite(x)) {
+    lo = x == infinity ? largest : -infinity;
+    hi = x == -infinity ? -largest : infinity;
+  } else if (!std::isfinite(e)) {
+    lo = nextDown(x);
+    hi = nextUp(x);
+  } else {
+    lo = e < 0 ? nextDown(x) : x;
+    hi = e > 0 ? nextUp(x) : x;
+  }
+}
+
+} // namespace detail
+
+// A closed interval [lo, hi] of doubles
+// guaranteed to contain the exact value of a computation.
+//
+// Every operation rounds the lower bound down and
+// the upper bound up. Instead of switching the FPU rounding
+// mode, results are computed to nearest and the exact error
+// is recovered by error-free transformations, so the bounds
+// are as tight as true directed rounding would give,
+// and exact results stay single points.
+//
+// Comparisons answer "certainly": a < b iff every value of a
+// is less than every value of b, while a == b iff the intervals
+// overlap, i.e. the values cannot be told apart.
+// Hence sign(x) from Geometry.hpp is non-zero only when
+// the sign is certain; certifiedSign also reports certainty.
+class IntervalReal {
+  double lo;
+  double hi;
+
+public:
+  // Default constructor: exact zero.
+  constexpr IntervalReal() : lo(0), hi(0) {}
+
+  // Construct from a number, widening by an ulp
+  // when it is not representable as a double.
+  template <typename T, typename = std::enable_if_t<
+                            std::is_arithmetic<T>::value ||
+                            std::is_constructible<long double, T>::value>>
+  IntervalReal(T x) {
+    double d = static_cast<double>(x);
+    lo = hi = d;
+    if constexpr (!std::is_same<T, double>::value &&
+                  !std::is_same<T, float>::value) {
+      if (static_cast<long double>(d) < static_cast<long double>(x))
+        hi = detail::nextUp(d);
+      else if (static_cast<long double>(d) > static_cast<long double>(x))
+        lo = detail::nextDown(d);
+    }
+  }
+
+  // Construct from bounds, lo <= hi.
+  static constexpr IntervalReal fromBounds(double lo, double hi) {
+    IntervalReal result;
+    result.lo = lo;
+    result.hi = hi;
+    return result;
+  }
+
+  constexpr double lower() const { return lo; }
+  constexpr double upper() const { return hi; }
+  constexpr double width() const { return hi - lo; }
+  constexpr bool isPoint() const { return lo == hi; }
+  constexpr bool contains(double x) const { return lo <= x && x <= hi; }
+
+  // Explicit conversion to primitive types gives the midpoint.
+  template <typename U>
+  constexpr explicit operator U() const {
+    return static_cast<U>(lo / 2 + hi / 2);
+  }
+
+  // Arithmetic operators.
+  IntervalReal &operator+=(IntervalReal other) {
+    double s, e, unused;
+    detail::twoSum(lo, other.lo, s, e);
+    detail::roundOutward(s, e, lo, unused);
+    detail::twoSum(hi, other.hi, s, e);
+    detail::roundOutward(s, e, unused, hi);
+    return *this;
+  }
+  IntervalReal &operator-=(IntervalReal other) { return *this += -other; }
+  IntervalReal &operator*=(IntervalReal other) {
+    double lower[4], upper[4];
+    double lhs[2] = {lo, hi}, rhs[2] = {other.lo, other.hi};
+    for (int i = 0; i < 4; ++i) {
+      double p, e;
+      detail::twoProduct(lhs[i / 2], rhs[i % 2], p, e);
+      detail::roundOutward(p, e, lower[i], upper[i]);
+    }
+    lo = std::min({lower[0], lower[1], lower[2], lower[3]});
+    hi = std::max({upper[0], upper[1], upper[2], upper[3]});
+    return *this;
+  }
+  // Division by an interval containing zero gives the whole line.
+  IntervalReal &operator/=(IntervalReal other) {
+    if (other.contains(0)) {
+      lo = -std::numeric_limits<double>::infinity();
+      hi = std::numeric_limits<double>::infinity();
+      return *this;
+    }
+    double q[4] = {lo / other.lo, lo / other.hi, hi / other.lo,
+                   hi / other.hi};
+    lo = detail::nextDown(std::min({q[0], q[1], q[2], q[3]}));
+    hi = detail::nextUp(std::max({q[0], q[1], q[2], q[3]}));
+    return *this;
+  }
+  friend IntervalReal operator+(IntervalReal lhs, IntervalReal rhs) {
+    return lhs += rhs;
+  }
+  friend IntervalReal operator-(IntervalReal lhs, IntervalReal rhs) {
+    return lhs -= rhs;
+  }
+  friend IntervalReal operator*(IntervalReal lhs, IntervalReal rhs) {
+    return lhs *= rhs;
+  }
+  friend IntervalReal operator/(IntervalReal lhs, IntervalReal rhs) {
+    return lhs /= rhs;
+  }
+  constexpr IntervalReal operator+() const { return *this; }
+  constexpr IntervalReal operator-() const { return fromBounds(-hi, -lo); }
+
+  // Certain comparisons, see the class comment.
+  constexpr friend bool operator==(IntervalReal lhs, IntervalReal rhs) {
+    return lhs.lo <= rhs.hi && rhs.lo <= lhs.hi;
+  }
+  constexpr friend bool operator!=(IntervalReal lhs, IntervalReal rhs) {
+    return !(lhs == rhs);
+  }
+  constexpr friend bool operator<(IntervalReal lhs, IntervalReal rhs) {
+    return lhs.hi < rhs.lo;
+  }
+  constexpr friend bool operator>(IntervalReal lhs, IntervalReal rhs) {
+    return rhs < lhs;
+  }
+  constexpr friend bool operator<=(IntervalReal lhs, IntervalReal rhs) {
+    return !(rhs < lhs);
+  }
+  constexpr friend bool operator>=(IntervalReal lhs, IntervalReal rhs) {
+    return !(lhs < rhs);
+  }
+
+  // I/O stream operators.
+  //
+  // Input reads a single number, output prints [lo, hi].
+  friend std::istream &operator>>(std::istream &is, IntervalReal &x) {
+    long double value;
+    if (is >> value)
+      x = value;
+    return is;
+  }
+  friend std::ostream &operator<<(std::ostream &os, IntervalReal x) {
+    return os << '[' << x.lo << ", " << x.hi << ']';
+  }
+};
+
+// The sign of an interval, if it is certain.
+struct CertifiedSign {
+  // -1, 0 or +1; meaningful only if certain is set.
+  int32_t value;
+  bool certain;
+};
+
+// The sign of x: certain if x does not contain zero,
+// or is exactly the point zero.
+constexpr CertifiedSign certifiedSign(IntervalReal x) {
+  if (x.lower() > 0)
+    return {+1, true};
+  if (x.upper() < 0)
+    return {-1, true};
+  return {0, x.isPoint()};
+}
+
+// A filtered predicate: the sign of the interval approximation
+// if it is certain, otherwise the result of the exact fallback,
+// which is only evaluated in that case.
+template <typename Exact>
+int32_t filteredSign(IntervalReal approximation, Exact exact) {
+  CertifiedSign s = certifiedSign(approximation);
+  return s.certain ? s.value : exact();
+}
+
+// Overloads of some functions from <cmath> for IntervalReal.
+inline IntervalReal fabs(IntervalReal x) {
+  if (x.lower() >= 0)
+    return x;
+  if (x.upper() <= 0)
+    return -x;
+  return IntervalReal::fromBounds(0, std::max(-x.lower(), x.upper()));
+}
+inline IntervalReal sqrt(IntervalReal x) {
+  // std::sqrt is correctly rounded, so one ulp outwards is enough.
+  double lo = x.lower() > 0 ? detail::nextDown(std::sqrt(x.lower())) : 0;
+  double hi = x.upper() > 0 ? detail::nextUp(std::sqrt(x.upper())) : 0;
+  return IntervalReal::fromBounds(std::max(lo, 0.0), hi);
+}
+
+} // namespace numeric
+} // namespace acmlib
@@ -0,0 +1,345 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Arena.hpp"
+
+namespace acmlib {
+namespace parallel {
+
+// Execution policies of bulk algorithms.
+enum class Execution {
+  // A plain loop on the calling thread.
+  Sequential,
+  // Blocks of the range are run by the thread pool.
+  Parallel,
+  // As Parallel, and additionally the loop over a block
+  // is declared free of dependencies between iterations,
+  // so the compiler may vectorize it.
+  // Inputs must not alias outputs.
+  ParallelSimd,
+};
+
+// A work-stealing thread pool.
+//
+// Every worker owns a deque of tasks: it pushes and pops
+// its own tasks at the back, and when it runs out of work
+// it steals from the front of other deques, where the
+// oldest and usually largest tasks are. Tasks submitted
+// by threads outside the pool go to a shared deque.
+//
+// Threads waiting for a TaskGroup execute pending tasks
+// instead of blocking, so nested fork/join never deadlocks
+// and the calling thread counts as one more worker:
+// a pool without workers runs everything on the caller.
+class ThreadPool {
+public:
+  // Starts the given number of worker threads.
+  explicit ThreadPool(size_t workers) : queues(workers + 1) {
+    for (auto &queue : queues)
+      queue = std::make_unique<Queue>();
+    threads.reserve(workers);
+    for (size_t i = 1; i <= workers; ++i)
+      threads.emplace_back([this, i] { work(i); });
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Finishes the submitted tasks and joins the workers.
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &thread : threads)
+      thread.join();
+  }
+
+  // The process-wide pool with one worker
+  // per hardware thread besides the calling one.
+  static ThreadPool &global() {
+    static ThreadPool pool(
+        std::max<unsigned>(std::thread::hardware_concurrency(), 1) - 1);
+    return pool;
+  }
+
+  // The number of threads that may run tasks,
+  // counting the one waiting for them.
+  size_t size() const { return threads.size() + 1; }
+
+  // Schedules a task. Exceptions must not escape it,
+  // TaskGroup::run takes care of that.
+  void submit(std::function<void()> task) {
+    Queue &queue = *queues[current == this ? currentIndex : 0];
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+    }
+    pending.fetch_add(1, std::memory_order_release);
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wake.notify_one();
+  }
+
+  // Runs one pending task on the calling thread, if there is any.
+  // Returns false if no task was found.
+  bool runPending() {
+    size_t home = current == this ? currentIndex : 0;
+    std::function<void()> task;
+    if (!take(home, task))
+      return false;
+    task();
+    return true;
+  }
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  // Pops the back of the own queue, or steals
+  // the front of another one.
+  bool take(size_t home, std::function<void()> &task) {
+    if (pending.load(std::memory_order_acquire) == 0)
+      return false;
+    for (size_t k = 0; k < queues.size(); ++k) {
+      size_t i = (home + k) % queues.size();
+      Queue &queue = *queues[i];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.tasks.empty())
+        continue;
+      if (i == home) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+      pending.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+  void work(size_t index) {
+    current = this;
+    currentIndex = index;
+    std::function<void()> task;
+    while (true) {
+      if (take(index, task)) {
+        task();
+        task = nullptr;
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleepMutex);
+      wake.wait(lock, [this] {
+        return stopping || pending.load(std::memory_order_acquire) > 0;
+      });
+      if (stopping && pending.load(std::memory_order_acquire) == 0)
+        return;
+    }
+  }
+
+  // The pool whose worker the current thread is, and its queue.
+  static inline thread_local ThreadPool *current = nullptr;
+  static inline thread_local size_t currentIndex = 0;
+
+  // Queue 0 is shared, queue i is owned by the i-th worker.
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> threads;
+  std::atomic<size_t> pending{0};
+  std::mutex sleepMutex;
+  std::condition_variable wake;
+  bool stopping = false;
+};
+
+// A set of tasks to fork and then join.
+//
+// The first exception thrown by a task is rethrown by wait,
+// the tasks still run to completion.
+class TaskGroup {
+public:
+  explicit TaskGroup(ThreadPool &pool = ThreadPool::global()) : pool(pool) {}
+
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  // Joins the remaining tasks; their exceptions are lost.
+  ~TaskGroup() {
+    while (running.load(std::memory_order_acquire) > 0)
+      help();
+  }
+
+  // Forks a task.
+  template <typename F>
+  void run(F f) {
+    running.fetch_add(1, std::memory_order_relaxed);
+    pool.submit([this, f = std::move(f)]() mutable {
+      try {
+        f();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error)
+          error = std::current_exception();
+      }
+      running.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  // Joins all forked tasks, running pending tasks meanwhile.
+  void wait() {
+    while (running.load(std::memory_order_acquire) > 0)
+      help();
+    if (error)
+      std::rethrow_exception(std::exchange(error, nullptr));
+  }
+
+private:
+  void help() {
+    if (!pool.runPending())
+      std::this_thread::yield();
+  }
+
+  ThreadPool &pool;
+  std::atomic<size_t> running{0};
+  std::mutex errorMutex;
+  std::exception_ptr error;
+};
+
+namespace detail {
+
+// Forks the upper halves of [begin, end) until
+// pieces have at most grain elements.
+template <typename F>
+void splitRange(TaskGroup &group, size_t begin, size_t end, size_t grain,
+                const F &f) {
+  while (end - begin > grain) {
+    size_t middle = begin + (end - begin) / 2;
+    group.run([&group, middle, end, grain, &f] {
+      splitRange(group, middle, end, grain, f);
+    });
+    end = middle;
+  }
+  f(begin, end);
+}
+
+} // namespace detail
+
+// Calls f(blockBegin, blockEnd) on blocks covering [begin, end),
+// each of at most grain elements, in parallel.
+//
+// The range is split recursively, so idle threads
+// steal large halves and the load balances itself.
+template <typename F>
+void parallelFor(size_t begin, size_t end, F f, size_t grain,
+                 ThreadPool &pool) {
+  grain = std::max<size_t>(grain, 1);
+  if (end <= begin)
+    return;
+  if (pool.size() == 1) {
+    for (; end - begin > grain; begin += grain)
+      f(begin, begin + grain);
+    f(begin, end);
+    return;
+  }
+  TaskGroup group(pool);
+  detail::splitRange(group, begin, end, grain, f);
+  group.wait();
+}
+
+// As above on the global pool, which is not created
+// for a range of a single block.
+template <typename F>
+void parallelFor(size_t begin, size_t end, F f, size_t grain = 1) {
+  if (end > begin && end - begin <= std::max<size_t>(grain, 1)) {
+    f(begin, end);
+    return;
+  }
+  parallelFor(begin, end, f, grain, ThreadPool::global());
+}
+
+// Reduces [begin, end) split into consecutive blocks
+// of exactly grain elements (the last one may be shorter):
+// block(blockBegin, blockEnd) computes the partial result
+// of a block in parallel, and combine(acc, partial) folds
+// the partial results into init in block order.
+//
+// Block boundaries depend only on grain, so the result
+// is reproducible for any number of threads,
+// even for non-associative operations like floating-point sums.
+// Partial results are kept in the caller's memory::Arena.
+template <typename R, typename Block, typename Combine>
+R parallelReduce(size_t begin, size_t end, R init, Block block,
+                 Combine combine, size_t grain = 1,
+                 ThreadPool &pool = ThreadPool::global()) {
+  grain = std::max<size_t>(grain, 1);
+  if (end <= begin)
+    return init;
+  size_t blocks = (end - begin - 1) / grain + 1;
+  memory::Arena &arena = memory::Arena::local();
+  memory::Arena::Scope scope(arena);
+  std::pmr::vector<R> partial(&arena);
+  partial.resize(blocks);
+  parallelFor(
+      0, blocks,
+      [&](size_t first, size_t last) {
+        for (size_t k = first; k < last; ++k)
+          partial[k] = block(begin + k * grain,
+                             begin + std::min(end - begin, (k + 1) * grain));
+      },
+      1, pool);
+  for (R &value : partial)
+    init = combine(std::move(init), std::move(value));
+  return init;
+}
+
+// Runs the given functions in parallel and returns
+// when all of them are done: a one-shot fork/join.
+template <typename... F>
+void parallelInvoke(F &&...f) {
+  TaskGroup group;
+  (group.run(std::forward<F>(f)), ...);
+  group.wait();
+}
+
+// Solves n independent test cases in parallel.
+//
+// solve(i, out) must print the answer of the i-th case
+// to the std::ostream out; the answers are written to os
+// in order of cases once all of them are ready. os may be
+// any output taking a std::string, e.g. an io::Writer, so
+// that the answers stay in order with its other output.
+// Input should be read beforehand, since cases run in any order.
+template <typename Solve, typename Output = std::ostream>
+void solveInParallel(size_t n, Solve solve, Output &os = std::cout,
+                     ThreadPool &pool = ThreadPool::global()) {
+  std::vector<std::ostringstream> answers(n);
+  parallelFor(
+      0, n,
+      [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+          solve(i, static_cast<std::ostream &>(answers[i]));
+      },
+      1, pool);
+  for (std::ostringstream &answer : answers)
+    os << answer.str();
+}
+
+} // namespace parallel
+} // namespace acmlib
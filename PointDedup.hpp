@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+#include "Arena.hpp"
+#include "Geometry.hpp"
+#include "GeometryBulk.hpp"
+#include "RadixSort.hpp"
+#include "SpatialSort.hpp"
+
+namespace acmlib {
+namespace geometry {
+
+// Removes duplicates from n points with integral coordinates
+// and returns the number of distinct points, which are left
+// sorted lexicographically at the front of the array.
+//
+// The sort is lexicographicSort, run by the global thread
+// pool unless E is Execution::Sequential.
+template <Execution E = Execution::Sequential, typename T>
+size_t deduplicate(Point<T> *points, size_t n) {
+  static_assert(std::is_integral<T>::value,
+                "deduplicate needs integral coordinates, "
+                "see mergeNearDuplicates for reals");
+  lexicographicSort(points, n, E == Execution::Sequential ? 1 : 0);
+  return std::unique(points, points + n) - points;
+}
+
+// Overload for std::vector: erases the duplicates.
+template <Execution E = Execution::Sequential, typename T>
+void deduplicate(std::vector<Point<T>> &points) {
+  points.resize(deduplicate<E>(points.data(), points.size()));
+}
+
+namespace detail {
+
+// The cell of a point on the grid of square cells of side
+// 4 eps, and the direction of the nearer neighbouring cell
+// on each axis. Points equal as RPoints are less than a
+// quarter of a cell apart, so they are in the same cell
+// or in the neighbour toward the nearer side on each axis,
+// even with the rounding of the division.
+struct NearDuplicateCell {
+  LPoint cell;
+  int8_t dx, dy;
+};
+
+inline NearDuplicateCell nearDuplicateCell(RPoint P) {
+  constexpr Real::PrimitiveReal side = 4 * Real::eps;
+  Real::PrimitiveReal x = static_cast<Real::PrimitiveReal>(P.x()) / side;
+  Real::PrimitiveReal y = static_cast<Real::PrimitiveReal>(P.y()) / side;
+  Real::PrimitiveReal cx = std::floor(x), cy = std::floor(y);
+  return {{static_cast<int64_t>(cx), static_cast<int64_t>(cy)},
+          static_cast<int8_t>(x - cx < 0.5 ? -1 : 1),
+          static_cast<int8_t>(y - cy < 0.5 ? -1 : 1)};
+}
+
+// A well mixed 64-bit hash of a cell.
+inline uint64_t cellHash(LPoint cell) {
+  uint64_t h = static_cast<uint64_t>(cell.x()) * 0x9e3779b97f4a7c15ull ^
+               static_cast<uint64_t>(cell.y());
+  h = (h ^ (h >> 31)) * 0xbf58476d1ce4e5b9ull;
+  h = (h ^ (h >> 29)) * 0x94d049bb133111ebull;
+  return h ^ (h >> 32);
+}
+
+// The 2 x 2 cells that may hold points equal to a point
+// in the given cell, its own cell first.
+inline std::array<LPoint, 4> nearDuplicateNeighbours(NearDuplicateCell c) {
+  return {c.cell, c.cell + LVector(c.dx, 0), c.cell + LVector(0, c.dy),
+          c.cell + LVector(c.dx, c.dy)};
+}
+
+// An open addressing table from cell hashes to indices,
+// sized for a given number of distinct hashes.
+// Stored indices must not be none.
+class CellTable {
+public:
+  static constexpr size_t none = SIZE_MAX;
+
+  CellTable(size_t capacity, std::pmr::memory_resource *resource)
+      : slots(resource) {
+    size_t size = 2;
+    while (size < 2 * capacity)
+      size *= 2;
+    slots.assign(size, Slot{0, none});
+  }
+
+  // The index stored for a hash, or none.
+  size_t find(uint64_t h) const { return slots[slot(h)].index; }
+
+  // The index stored for a hash, none if it was not there yet.
+  size_t &operator[](uint64_t h) {
+    Slot &s = slots[slot(h)];
+    s.hash = h;
+    return s.index;
+  }
+
+private:
+  struct Slot {
+    uint64_t hash;
+    size_t index;
+  };
+
+  // The slot of a hash: its own if present, else an empty one.
+  size_t slot(uint64_t h) const {
+    size_t mask = slots.size() - 1;
+    size_t s = h & mask;
+    while (slots[s].index != none && slots[s].hash != h)
+      s = (s + 1) & mask;
+    return s;
+  }
+
+  std::pmr::vector<Slot> slots;
+};
+
+// Points grouped by the hash of their cell, for finding
+// the points of a cell without per-cell allocations.
+// Storage comes from the given memory::Arena.
+class CellGroups {
+public:
+  static constexpr size_t none = CellTable::none;
+
+  CellGroups(const NearDuplicateCell *cells, size_t n, size_t threads,
+             memory::Arena &arena)
+      : order(n, &arena), begin(&arena), table(0, &arena) {
+    std::pmr::vector<uint64_t> hash(n, &arena);
+    for (size_t i = 0; i < n; ++i)
+      order[i] = i;
+    algorithm::radixSortByKey(
+        order.data(), n, [&](size_t i) { return cellHash(cells[i].cell); },
+        threads);
+    size_t groups = 0;
+    for (size_t k = 0; k < n; ++k) {
+      hash[k] = cellHash(cells[order[k]].cell);
+      groups += k == 0 || hash[k] != hash[k - 1];
+    }
+    begin.reserve(groups + 1);
+    for (size_t k = 0; k < n; ++k)
+      if (k == 0 || hash[k] != hash[k - 1])
+        begin.push_back(k);
+    begin.push_back(n);
+    table = CellTable(groups, &arena);
+    for (size_t g = 0; g < groups; ++g)
+      table[hash[begin[g]]] = g;
+  }
+
+  size_t groups() const { return begin.size() - 1; }
+
+  // The group of the points whose cell has the hash
+  // of the given cell, or none.
+  size_t find(LPoint cell) const { return table.find(cellHash(cell)); }
+
+  // Calls f(j) for the index j of every point of group g
+  // until f returns true, and returns whether it did.
+  template <typename F>
+  bool any(size_t g, F f) const {
+    if (g == none)
+      return false;
+    for (size_t k = begin[g]; k < begin[g + 1]; ++k)
+      if (f(order[k]))
+        return true;
+    return false;
+  }
+
+private:
+  std::pmr::vector<size_t> order;
+  std::pmr::vector<size_t> begin;
+  CellTable table;
+};
+
+} // namespace detail
+
+// Merges points equal as RPoints, i.e. closer than Real::eps
+// on both axes, and returns the number of points left,
+// which keep their input order at the front of the array.
+//
+// A point is dropped iff it equals an earlier point that was
+// kept, so kept points are pairwise different and every
+// dropped point equals a kept one. Unlike merging the pairs
+// found by an epsilon comparator sort, chains of points
+// each within eps of the next are not collapsed.
+//
+// Points are bucketed on a grid of cells of side 4 eps
+// and compared with the points of 2 x 2 cells only.
+// Sequentially this is one pass over the points with
+// a hash table of the kept ones. Under the other policies
+// the points having any near duplicate are first searched
+// for by the global thread pool, and the order dependent
+// pass only visits those. Coordinates must be below
+// 2^62 eps (about 4.6e9) in absolute value.
+// Scratch buffers come from the thread's memory::Arena.
+template <Execution E = Execution::Sequential>
+size_t mergeNearDuplicates(RPoint *points, size_t n) {
+  memory::Arena &arena = memory::Arena::local();
+  memory::Arena::Scope scope(arena);
+  constexpr size_t none = detail::CellTable::none;
+
+  if constexpr (E == Execution::Sequential) {
+    // The last kept point of every cell hash,
+    // and the previous kept one of every kept point.
+    detail::CellTable last(n, &arena);
+    std::pmr::vector<size_t> previous(n, &arena);
+    size_t m = 0;
+    for (size_t i = 0; i < n; ++i) {
+      detail::NearDuplicateCell c = detail::nearDuplicateCell(points[i]);
+      bool merged = false;
+      for (LPoint cell : detail::nearDuplicateNeighbours(c))
+        for (size_t j = last.find(detail::cellHash(cell));
+             j != none && !merged; j = previous[j])
+          merged = points[j] == points[i];
+      if (merged)
+        continue;
+      size_t &head = last[detail::cellHash(c.cell)];
+      previous[m] = head;
+      head = m;
+      points[m++] = points[i];
+    }
+    return m;
+  } else {
+    std::pmr::vector<detail::NearDuplicateCell> cells(n, &arena);
+    detail::bulkFor<E>(
+        n, [&](size_t i) { cells[i] = detail::nearDuplicateCell(points[i]); });
+    detail::CellGroups grid(cells.data(), n, 0, arena);
+
+    // Points without any near duplicate are kept in any case;
+    // the groups of the 2 x 2 cells around the others are kept.
+    std::pmr::vector<std::array<size_t, 4>> neighbours(n, &arena);
+    std::pmr::vector<uint8_t> hasDuplicate(n, &arena);
+    detail::bulkFor<E>(n, [&](size_t i) {
+      std::array<LPoint, 4> around = detail::nearDuplicateNeighbours(cells[i]);
+      std::array<size_t, 4> &groups = neighbours[i];
+      for (int k = 0; k < 4; ++k)
+        groups[k] = grid.find(around[k]);
+      for (int k = 0; k < 4 && !hasDuplicate[i]; ++k)
+        hasDuplicate[i] = grid.any(groups[k], [&](size_t j) {
+          return j != i && points[j] == points[i];
+        });
+    });
+
+    // Greedy in input order over points with near duplicates,
+    // with the kept ones in a list per group; lists are short
+    // since kept points are pairwise different.
+    std::pmr::vector<size_t> keptHead(grid.groups(), none, &arena);
+    std::pmr::vector<size_t> keptNext(n, none, &arena);
+    size_t m = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (hasDuplicate[i]) {
+        const std::array<size_t, 4> &groups = neighbours[i];
+        bool merged = false;
+        for (int k = 0; k < 4 && !merged; ++k)
+          if (groups[k] != none)
+            for (size_t j = keptHead[groups[k]]; j != none && !merged;
+                 j = keptNext[j])
+              merged = points[j] == points[i];
+        if (merged)
+          continue;
+        keptNext[m] = keptHead[groups[0]];
+        keptHead[groups[0]] = m;
+      }
+      points[m++] = points[i];
+    }
+    return m;
+  }
+}
+
+// Overload for std::vector: erases the merged points.
+template <Execution E = Execution::Sequential>
+void mergeNearDuplicates(std::vector<RPoint> &points) {
+  points.resize(mergeNearDuplicates<E>(points.data(), points.size()));
+}
+
+} // namespace geometry
+} // namespace acmlib
@@ -0,0 +1,350 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Arena.hpp"
+#include "FastIO.hpp"
+#include "Geometry.hpp"
+
+namespace acmlib {
+namespace io {
+
+// A binary file format for point sets and polygons.
+//
+// The file starts with a 64-byte header:
+//
+//   offset size
+//        0    8  magic "ACMPTS\0" and format version 1
+//        8    4  byte order mark 0x01020304, native order
+//       12    4  coordinate type, see CoordinateType
+//       16    4  layout, see Layout
+//       20    4  reserved, zero
+//       24    8  number of points n
+//       32    8  number of polygons m, 0 for a plain point set
+//       40    8  offset of the coordinate data
+//       48    8  offset of the polygon table
+//       56    8  reserved, zero
+//
+// The coordinate data is either n interleaved points x y,
+// which is the memory layout of Vector<T>, or a block of n x
+// coordinates followed by a block of n y coordinates.
+// The polygon table holds m + 1 increasing uint64_t indices:
+// the i-th polygon consists of points [table[i], table[i + 1]).
+// Every block starts at a multiple of 64 bytes, so a mapped
+// file is used in place, with no parsing or copying at all.
+
+// Type of the coordinates stored in a file.
+enum class CoordinateType : uint32_t { Int32, Int64, Float, Double };
+
+// Arrangement of the coordinates in a file.
+enum class Layout : uint32_t {
+  // x0 y0 x1 y1 ..., readable as an array of Vector<T>.
+  Interleaved,
+  // x0 x1 ... followed by y0 y1 ..., convenient for SIMD.
+  Columns,
+};
+
+// The CoordinateType of T.
+template <typename T>
+constexpr CoordinateType coordinateTypeOf() {
+  if constexpr (std::is_same<T, int32_t>::value)
+    return CoordinateType::Int32;
+  else if constexpr (std::is_same<T, int64_t>::value)
+    return CoordinateType::Int64;
+  else if constexpr (std::is_same<T, float>::value)
+    return CoordinateType::Float;
+  else {
+    static_assert(std::is_same<T, double>::value,
+                  "coordinates must be int32_t, int64_t, float or double");
+    return CoordinateType::Double;
+  }
+}
+
+// A contiguous read-only range of n elements.
+template <typename T>
+struct Span {
+  const T *pointer = nullptr;
+  size_t length = 0;
+
+  const T *data() const { return pointer; }
+  size_t size() const { return length; }
+  bool empty() const { return length == 0; }
+  const T &operator[](size_t i) const { return pointer[i]; }
+  const T *begin() const { return pointer; }
+  const T *end() const { return pointer + length; }
+};
+
+// Points stored as separate x and y columns.
+template <typename T>
+struct Columns {
+  Span<T> x;
+  Span<T> y;
+
+  size_t size() const { return x.size(); }
+  geometry::Point<T> operator[](size_t i) const { return {x[i], y[i]}; }
+};
+
+namespace detail {
+
+constexpr char pointFileMagic[8] = {'A', 'C', 'M', 'P', 'T', 'S', '\0', 1};
+constexpr uint32_t pointFileByteOrder = 0x01020304;
+constexpr uint64_t pointFileAlignment = 64;
+
+struct PointFileHeader {
+  char magic[8];
+  uint32_t byteOrder;
+  CoordinateType type;
+  Layout layout;
+  uint32_t reserved0;
+  uint64_t points;
+  uint64_t polygons;
+  uint64_t coordinatesOffset;
+  uint64_t polygonsOffset;
+  uint64_t reserved1;
+};
+static_assert(sizeof(PointFileHeader) == 64);
+
+constexpr uint64_t alignUp(uint64_t offset) {
+  return (offset + pointFileAlignment - 1) / pointFileAlignment *
+         pointFileAlignment;
+}
+
+// Writes a whole point file; polygons may be null if m = 0.
+// Columns are gathered in the thread's memory::Arena.
+template <typename T>
+void writePointFile(const std::string &path, const geometry::Point<T> *points,
+                    uint64_t n, const uint64_t *polygons, uint64_t m,
+                    Layout layout) {
+  static_assert(sizeof(geometry::Point<T>) == 2 * sizeof(T));
+  PointFileHeader header{};
+  std::memcpy(header.magic, pointFileMagic, sizeof(header.magic));
+  header.byteOrder = pointFileByteOrder;
+  header.type = coordinateTypeOf<T>();
+  header.layout = layout;
+  header.points = n;
+  header.polygons = m;
+  header.coordinatesOffset = alignUp(sizeof(header));
+  uint64_t coordinatesEnd = header.coordinatesOffset + 2 * n * sizeof(T);
+  if (layout == Layout::Columns)
+    coordinatesEnd = alignUp(header.coordinatesOffset + n * sizeof(T)) +
+                     n * sizeof(T);
+  header.polygonsOffset = m ? alignUp(coordinatesEnd) : 0;
+
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  if (!file)
+    throw std::runtime_error("cannot open " + path + " for writing");
+  uint64_t written = 0;
+  auto put = [&](const void *data, uint64_t size) {
+    if (std::fwrite(data, 1, size, file) != size) {
+      std::fclose(file);
+      throw std::runtime_error("cannot write " + path);
+    }
+    written += size;
+  };
+  auto padTo = [&](uint64_t offset) {
+    static const char zeros[pointFileAlignment] = {};
+    put(zeros, offset - written);
+  };
+  put(&header, sizeof(header));
+  padTo(header.coordinatesOffset);
+  if (layout == Layout::Interleaved) {
+    put(points, 2 * n * sizeof(T));
+  } else {
+    memory::Arena &arena = memory::Arena::local();
+    memory::Arena::Scope scope(arena);
+    std::pmr::vector<T> column(n, &arena);
+    for (int axis = 0; axis < 2; ++axis) {
+      for (uint64_t i = 0; i < n; ++i)
+        column[i] = points[i][axis];
+      padTo(alignUp(written));
+      put(column.data(), n * sizeof(T));
+    }
+  }
+  if (m) {
+    padTo(header.polygonsOffset);
+    put(polygons, (m + 1) * sizeof(uint64_t));
+  }
+  if (std::fclose(file) != 0)
+    throw std::runtime_error("cannot write " + path);
+}
+
+} // namespace detail
+
+// Writes n points to a point file.
+template <typename T>
+void writePointFile(const std::string &path, const geometry::Point<T> *points,
+                    size_t n, Layout layout = Layout::Interleaved) {
+  detail::writePointFile(path, points, n, nullptr, 0, layout);
+}
+
+// Writes polygons to a point file.
+template <typename T>
+void writePointFile(
+    const std::string &path,
+    const std::vector<std::vector<geometry::Point<T>>> &polygons,
+    Layout layout = Layout::Interleaved) {
+  std::vector<geometry::Point<T>> points;
+  std::vector<uint64_t> table{0};
+  for (const auto &polygon : polygons) {
+    points.insert(points.end(), polygon.begin(), polygon.end());
+    table.push_back(points.size());
+  }
+  detail::writePointFile(path, points.data(), points.size(), table.data(),
+                         polygons.size(), layout);
+}
+
+// A point file opened for reading.
+//
+// The file is memory-mapped where possible (and read into
+// memory otherwise), so opening costs next to nothing and
+// pages are loaded on first access. Spans returned by
+// the accessors are valid while the PointFile lives.
+//
+// Malformed files and requests for the wrong coordinate type
+// or layout throw std::runtime_error.
+class PointFile {
+public:
+  explicit PointFile(const std::string &path) {
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file)
+      throw std::runtime_error("cannot open " + path);
+#ifdef ACMLIB_FASTIO_MMAP
+    mapping = detail::MappedFile(fileno(file), false);
+#endif
+    if (mapping.data()) {
+      bytes = mapping.data();
+      length = mapping.size();
+    } else {
+      char chunk[1 << 16];
+      size_t size;
+      while ((size = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+        buffer.insert(buffer.end(), chunk, chunk + size);
+      bytes = buffer.data();
+      length = buffer.size();
+    }
+    std::fclose(file);
+    validate(path);
+  }
+
+  PointFile(const PointFile &) = delete;
+  PointFile &operator=(const PointFile &) = delete;
+
+  CoordinateType type() const { return header.type; }
+  Layout layout() const { return header.layout; }
+
+  // The number of points.
+  size_t size() const { return header.points; }
+
+  // The number of polygons, 0 for a plain point set.
+  size_t polygonCount() const { return header.polygons; }
+
+  // All points, for files in the Interleaved layout.
+  template <typename T>
+  Span<geometry::Point<T>> points() const {
+    check<T>(Layout::Interleaved);
+    return {reinterpret_cast<const geometry::Point<T> *>(
+                bytes + header.coordinatesOffset),
+            size()};
+  }
+
+  // All points, for files in the Columns layout.
+  template <typename T>
+  Columns<T> columns() const {
+    check<T>(Layout::Columns);
+    const char *x = bytes + header.coordinatesOffset;
+    const char *y = bytes + detail::alignUp(header.coordinatesOffset +
+                                            size() * sizeof(T));
+    return {{reinterpret_cast<const T *>(x), size()},
+            {reinterpret_cast<const T *>(y), size()}};
+  }
+
+  // The polygon table: polygonCount() + 1 point indices.
+  Span<uint64_t> polygonTable() const {
+    if (!header.polygons)
+      return {};
+    return {reinterpret_cast<const uint64_t *>(bytes + header.polygonsOffset),
+            polygonCount() + 1};
+  }
+
+  // Points of the i-th polygon, for files in the Interleaved layout.
+  template <typename T>
+  Span<geometry::Point<T>> polygon(size_t i) const {
+    Span<uint64_t> table = polygonTable();
+    return {points<T>().data() + table[i], table[i + 1] - table[i]};
+  }
+
+private:
+  [[noreturn]] static void malformed(const std::string &path,
+                                     const char *reason) {
+    throw std::runtime_error(path + ": " + reason);
+  }
+
+  static size_t coordinateSize(CoordinateType type) {
+    return type == CoordinateType::Int32 || type == CoordinateType::Float ? 4
+                                                                          : 8;
+  }
+
+  void validate(const std::string &path) {
+    if (length < sizeof(header))
+      malformed(path, "too short for a point file");
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, detail::pointFileMagic, 8) != 0)
+      malformed(path, "not a point file");
+    if (header.byteOrder != detail::pointFileByteOrder)
+      malformed(path, "byte order differs from this machine");
+    if (header.type > CoordinateType::Double || header.layout > Layout::Columns)
+      malformed(path, "unknown coordinate type or layout");
+    // Offsets and counts are bounded by the length first,
+    // so the end offsets below cannot wrap around.
+    uint64_t size = coordinateSize(header.type);
+    uint64_t n = header.points, m = header.polygons;
+    if (header.coordinatesOffset > length)
+      malformed(path, "coordinates out of bounds");
+    if (m && header.polygonsOffset > length)
+      malformed(path, "polygon table out of bounds");
+    uint64_t coordinatesEnd = header.coordinatesOffset + 2 * n * size;
+    if (header.layout == Layout::Columns)
+      coordinatesEnd =
+          detail::alignUp(header.coordinatesOffset + n * size) + n * size;
+    if (n > length || header.coordinatesOffset < sizeof(header) ||
+        header.coordinatesOffset % detail::pointFileAlignment ||
+        coordinatesEnd > length)
+      malformed(path, "coordinates out of bounds");
+    if (m) {
+      if (m > length || header.polygonsOffset % detail::pointFileAlignment ||
+          header.polygonsOffset < coordinatesEnd ||
+          header.polygonsOffset + (m + 1) * sizeof(uint64_t) > length)
+        malformed(path, "polygon table out of bounds");
+      Span<uint64_t> table = polygonTable();
+      if (table[0] != 0 || table[m] != n)
+        malformed(path, "polygon table does not cover the points");
+      for (uint64_t i = 0; i < m; ++i)
+        if (table[i] > table[i + 1])
+          malformed(path, "polygon table is not increasing");
+    }
+  }
+
+  template <typename T>
+  void check(Layout expected) const {
+    if (header.type != coordinateTypeOf<T>())
+      throw std::runtime_error("point file has other coordinate type");
+    if (header.layout != expected)
+      throw std::runtime_error("point file has other layout");
+  }
+
+  detail::MappedFile mapping;
+  std::vector<char> buffer;
+  const char *bytes = nullptr;
+  size_t length = 0;
+  detail::PointFileHeader header{};
+};
+
+} // namespace io
+} // namespace acmlib
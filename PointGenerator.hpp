@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Geometry.hpp"
+
+namespace acmlib {
+namespace geometry {
+
+// Point distributions for benchmarks and tests.
+enum class Distribution {
+  // Uniform in the square [-r, r] x [-r, r].
+  UniformSquare,
+  // Uniform in the disk of radius r around the origin.
+  UniformDisk,
+  // On the circle of radius r, rounded for integral types.
+  OnCircle,
+  // Eight Gaussian clusters with deviation r / 32,
+  // centered uniformly in the square.
+  GaussianClusters,
+  // Within distance 1 (r * 1e-9 for floating-point types)
+  // of a random line through the origin.
+  NearlyCollinear,
+  // A square grid over the square, every point moved
+  // by at most a quarter of the spacing.
+  JitteredGrid,
+  // (x, x^2) for n consecutive integers x centered at 0,
+  // shuffled: every point is a hull vertex.
+  HullAdversarial,
+  // Integers up to a quarter of the range of T in absolute
+  // value (2^62 for int64_t), whatever r is: products of
+  // coordinates overflow T.
+  HugeCoordinates,
+};
+
+namespace detail {
+
+constexpr double twoPi = 2 * static_cast<double>(pi);
+
+// Uniform double in [0, 1) from the top 53 bits.
+inline double unitUniform(std::mt19937_64 &rng) {
+  return static_cast<double>(rng() >> 11) * 0x1p-53;
+}
+
+// Uniform double in [-1, 1).
+inline double signedUniform(std::mt19937_64 &rng) {
+  return 2 * unitUniform(rng) - 1;
+}
+
+// Standard normal deviate by the Box-Muller transform.
+inline double gaussian(std::mt19937_64 &rng) {
+  double u = 1 - unitUniform(rng), v = unitUniform(rng);
+  return std::sqrt(-2 * std::log(u)) * std::cos(twoPi * v);
+}
+
+// The coordinate of type T nearest to x.
+template <typename T>
+T coordinate(double x) {
+  if constexpr (std::is_integral<T>::value)
+    return static_cast<T>(std::llround(x));
+  else
+    return T(x);
+}
+
+} // namespace detail
+
+// n points of the given distribution with coordinates
+// of type T, see Distribution for the meaning of radius.
+//
+// The output depends only on the arguments: random bits
+// come from std::mt19937_64, whose sequence is fixed by
+// the standard, and are turned into numbers and shuffles
+// here rather than by the implementation-defined
+// std:: distributions, so data sets are the same with any
+// standard library and results stay comparable over time.
+template <typename T>
+std::vector<Point<T>> generatePoints(Distribution distribution, size_t n,
+                                     uint64_t seed = 1,
+                                     double radius = 1 << 20) {
+  std::mt19937_64 rng(seed);
+  std::vector<Point<T>> points(n);
+  auto point = [](double x, double y) {
+    return Point<T>(detail::coordinate<T>(x), detail::coordinate<T>(y));
+  };
+  switch (distribution) {
+  case Distribution::UniformSquare:
+    for (auto &P : points) {
+      double x = detail::signedUniform(rng) * radius;
+      P = point(x, detail::signedUniform(rng) * radius);
+    }
+    break;
+  case Distribution::UniformDisk:
+  case Distribution::OnCircle:
+    for (auto &P : points) {
+      double angle = detail::twoPi * detail::unitUniform(rng);
+      double r = distribution == Distribution::OnCircle
+                     ? radius
+                     : radius * std::sqrt(detail::unitUniform(rng));
+      P = point(r * std::cos(angle), r * std::sin(angle));
+    }
+    break;
+  case Distribution::GaussianClusters: {
+    std::pair<double, double> centers[8];
+    for (auto &[x, y] : centers) {
+      x = detail::signedUniform(rng) * radius;
+      y = detail::signedUniform(rng) * radius;
+    }
+    for (auto &P : points) {
+      auto [x, y] = centers[rng() % 8];
+      double dx = detail::gaussian(rng) * radius / 32;
+      P = point(x + dx, y + detail::gaussian(rng) * radius / 32);
+    }
+    break;
+  }
+  case Distribution::NearlyCollinear: {
+    double angle = detail::twoPi * detail::unitUniform(rng);
+    double dx = std::cos(angle), dy = std::sin(angle);
+    double noise = std::is_integral<T>::value ? 1 : radius * 1e-9;
+    for (auto &P : points) {
+      double t = detail::signedUniform(rng) * radius;
+      double offset = detail::signedUniform(rng) * noise;
+      P = point(t * dx - offset * dy, t * dy + offset * dx);
+    }
+    break;
+  }
+  case Distribution::JitteredGrid: {
+    size_t side = std::max<size_t>(std::ceil(std::sqrt(double(n))), 1);
+    double spacing = 2 * radius / side;
+    for (size_t i = 0; i < n; ++i) {
+      double x = -radius + (i % side + 0.5) * spacing;
+      double y = -radius + (i / side + 0.5) * spacing;
+      double jx = detail::signedUniform(rng) * spacing / 4;
+      points[i] = point(x + jx, y + detail::signedUniform(rng) * spacing / 4);
+    }
+    break;
+  }
+  case Distribution::HullAdversarial:
+    for (size_t i = 0; i < n; ++i) {
+      double x = static_cast<double>(i) - static_cast<double>(n / 2);
+      points[i] = point(x, x * x);
+    }
+    break;
+  case Distribution::HugeCoordinates:
+    for (auto &P : points) {
+      if constexpr (std::is_integral<T>::value) {
+        constexpr int shift = 65 - 8 * sizeof(T);
+        T x = static_cast<T>(static_cast<int64_t>(rng()) >> shift);
+        P = {x, static_cast<T>(static_cast<int64_t>(rng()) >> shift)};
+      } else {
+        double x = detail::signedUniform(rng) * 0x1p62;
+        P = point(x, detail::signedUniform(rng) * 0x1p62);
+      }
+    }
+    break;
+  }
+  if (distribution == Distribution::HullAdversarial ||
+      distribution == Distribution::JitteredGrid) {
+    // Fisher-Yates, since std::shuffle is implementation-defined.
+    for (size_t i = n; i > 1; --i)
+      std::swap(points[i - 1], points[rng() % i]);
+  }
+  return points;
+}
+
+} // namespace geometry
+} // namespace acmlib
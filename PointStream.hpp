@@ -0,0 +1,383 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Arena.hpp"
+#include "FastIO.hpp"
+#include "Geometry.hpp"
+#include "GeometryBulk.hpp"
+#include "PointFile.hpp"
+
+namespace acmlib {
+namespace io {
+
+// Streaming of point sets larger than memory.
+//
+// A source fills a buffer with the next chunk of points:
+// source(buffer, capacity) returns how many points it stored,
+// 0 at the end of the stream. streamPoints passes the chunks
+// to a consumer, usually a few stages combined by stages(...),
+// and loads the next chunk on a background thread meanwhile.
+// Memory use is two chunks plus the state of the stages,
+// whatever the size of the input.
+
+// Points per chunk by default: 1 MiB of int64_t points.
+constexpr size_t defaultChunkSize = 1 << 16;
+
+namespace detail {
+
+// A background thread running one job at a time.
+class BackgroundWorker {
+public:
+  BackgroundWorker() : thread([this] { work(); }) {}
+
+  BackgroundWorker(const BackgroundWorker &) = delete;
+  BackgroundWorker &operator=(const BackgroundWorker &) = delete;
+
+  // Finishes the running job, if any, and joins the thread.
+  ~BackgroundWorker() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    changed.notify_all();
+    thread.join();
+  }
+
+  // Starts a job; the previous one must have been waited for.
+  void start(std::function<void()> next) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      job = std::move(next);
+    }
+    changed.notify_all();
+  }
+
+  // Waits for the started job and rethrows its exception.
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] { return !job; });
+    if (error)
+      std::rethrow_exception(std::exchange(error, nullptr));
+  }
+
+private:
+  void work() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      changed.wait(lock, [this] { return stopping || job; });
+      if (!job)
+        return;
+      lock.unlock();
+      std::exception_ptr failure;
+      try {
+        job();
+      } catch (...) {
+        failure = std::current_exception();
+      }
+      lock.lock();
+      error = failure;
+      job = nullptr;
+      changed.notify_all();
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::function<void()> job;
+  std::exception_ptr error;
+  bool stopping = false;
+  std::thread thread;
+};
+
+} // namespace detail
+
+// Passes all points of the source to consume(points, n)
+// in chunks of at most chunkSize points, and returns
+// the total number of points.
+//
+// Chunks are double-buffered: while one is consumed,
+// the next one is loaded by a background thread,
+// so I/O and parsing overlap with computation.
+// Exceptions of the source and of the consumer
+// are propagated to the caller.
+template <typename T, typename Source, typename Consume>
+uint64_t streamPoints(Source &&source, Consume &&consume,
+                      size_t chunkSize = defaultChunkSize) {
+  chunkSize = std::max<size_t>(chunkSize, 1);
+  std::vector<geometry::Point<T>> current(chunkSize), next(chunkSize);
+  size_t count = source(current.data(), chunkSize), nextCount = 0;
+  uint64_t total = 0;
+  detail::BackgroundWorker loader;
+  while (count > 0) {
+    loader.start([&] { nextCount = source(next.data(), chunkSize); });
+    consume(static_cast<const geometry::Point<T> *>(current.data()), count);
+    total += count;
+    loader.wait();
+    std::swap(current, next);
+    count = nextCount;
+  }
+  return total;
+}
+
+// A consumer feeding every chunk to all of the given stages,
+// which are held by reference.
+template <typename... Stage>
+auto stages(Stage &...stage) {
+  return [&stage...](const auto *points, size_t n) { (stage(points, n), ...); };
+}
+
+// A source parsing text points "x y" from a Reader:
+// the given number of points, or all until the end of input.
+template <typename T>
+class ReaderSource {
+public:
+  explicit ReaderSource(Reader &in, uint64_t count = UINT64_MAX)
+      : in(in), remaining(count) {}
+
+  size_t operator()(geometry::Point<T> *buffer, size_t capacity) {
+    size_t n = static_cast<size_t>(std::min<uint64_t>(capacity, remaining));
+    size_t stored = 0;
+    while (stored < n && in >> buffer[stored])
+      ++stored;
+    remaining -= stored;
+    return stored;
+  }
+
+private:
+  Reader &in;
+  uint64_t remaining;
+};
+
+// A source copying the points of a PointFile of either layout
+// chunk by chunk, which also pages the mapped file in
+// on the background thread.
+template <typename T>
+class PointFileSource {
+public:
+  explicit PointFileSource(const PointFile &file) : file(file) {}
+
+  size_t operator()(geometry::Point<T> *buffer, size_t capacity) {
+    size_t n = std::min(capacity, file.size() - position);
+    if (file.layout() == Layout::Interleaved) {
+      std::copy_n(file.points<T>().data() + position, n, buffer);
+    } else {
+      Columns<T> columns = file.columns<T>();
+      for (size_t i = 0; i < n; ++i)
+        buffer[i] = {columns.x[position + i], columns.y[position + i]};
+    }
+    position += n;
+    return n;
+  }
+
+private:
+  const PointFile &file;
+  size_t position = 0;
+};
+
+// Bounding box of the streamed points.
+template <typename T, geometry::Execution E = geometry::Execution::Sequential>
+class BoundingBoxStage {
+public:
+  void operator()(const geometry::Point<T> *points, size_t n) {
+    if (n == 0)
+      return;
+    geometry::Point<T> chunkLo, chunkHi;
+    geometry::boundingBox<E>(points, n, chunkLo, chunkHi);
+    if (total == 0) {
+      lower = chunkLo;
+      upper = chunkHi;
+    } else {
+      lower = {std::min(lower.x(), chunkLo.x()),
+               std::min(lower.y(), chunkLo.y())};
+      upper = {std::max(upper.x(), chunkHi.x()),
+               std::max(upper.y(), chunkHi.y())};
+    }
+    total += n;
+  }
+
+  // The number of points seen.
+  uint64_t count() const { return total; }
+
+  // Corners of the box, meaningful once count() > 0.
+  geometry::Point<T> lo() const { return lower; }
+  geometry::Point<T> hi() const { return upper; }
+
+private:
+  geometry::Point<T> lower, upper;
+  uint64_t total = 0;
+};
+
+// Convex hull of the streamed points in O(h) memory,
+// where h is the size of the hull.
+//
+// Every chunk goes through the Akl-Toussaint prefilter:
+// points strictly inside the octagon of the extreme points
+// seen so far in 8 directions (along the axes and diagonals)
+// cannot be hull vertices and are dropped with a few cross
+// products. The hull is then rebuilt from its vertices and
+// the few survivors by Andrew's monotone chain.
+//
+// Products are computed in T: with coordinates below 2^30
+// in absolute value for int64_t (2^14 for int32_t),
+// differences stay below 2^31 and cross products of
+// two of them below 2^63. The candidates of a chunk live
+// in the thread's memory::Arena; only the hull is kept.
+template <typename T>
+class HullStage {
+public:
+  void operator()(const geometry::Point<T> *points, size_t n) {
+    if (n == 0)
+      return;
+    if (seen == 0)
+      extremes.fill(points[0]);
+    seen += n;
+    for (size_t i = 0; i < n; ++i)
+      for (size_t k = 0; k < 8; ++k)
+        if ((points[i] ^ directions[k]) > (extremes[k] ^ directions[k]))
+          extremes[k] = points[i];
+
+    // The octagon, counterclockwise, without repeated corners.
+    std::array<geometry::Point<T>, 8> corners;
+    size_t m = 0;
+    for (geometry::Point<T> Q : extremes)
+      if (m == 0 || Q != corners[m - 1])
+        corners[m++] = Q;
+    while (m > 1 && corners[m - 1] == corners[0])
+      --m;
+    std::array<geometry::Vector<T>, 8> edges;
+    for (size_t k = 0; k < m; ++k)
+      edges[k] = corners[(k + 1) % m] - corners[k];
+
+    memory::Arena &arena = memory::Arena::local();
+    memory::Arena::Scope scope(arena);
+    std::pmr::vector<geometry::Point<T>> candidates(vertices.begin(),
+                                                    vertices.end(), &arena);
+    for (size_t i = 0; i < n; ++i) {
+      geometry::Point<T> P = points[i];
+      bool inside = m >= 3;
+      for (size_t k = 0; k < m; ++k)
+        inside &= edges[k] % (P - corners[k]) > 0;
+      if (!inside)
+        candidates.push_back(P);
+    }
+    survivors += candidates.size() - vertices.size();
+    rebuild(candidates);
+  }
+
+  // Vertices of the hull counterclockwise, starting from
+  // the lowest of the leftmost points, without collinear points.
+  const std::vector<geometry::Point<T>> &hull() const { return vertices; }
+
+  // The number of points that passed the prefilter.
+  uint64_t prefilterSurvivors() const { return survivors; }
+
+private:
+  // Directions of the octagon corners, counterclockwise
+  // starting from the leftmost one.
+  static constexpr std::array<geometry::Vector<T>, 8> directions = {
+      geometry::Vector<T>(-1, 0), geometry::Vector<T>(-1, -1),
+      geometry::Vector<T>(0, -1), geometry::Vector<T>(1, -1),
+      geometry::Vector<T>(1, 0),  geometry::Vector<T>(1, 1),
+      geometry::Vector<T>(0, 1),  geometry::Vector<T>(-1, 1)};
+
+  void rebuild(std::pmr::vector<geometry::Point<T>> &candidates) {
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                     candidates.end());
+    size_t m = candidates.size();
+    if (m < 3) {
+      vertices.assign(candidates.begin(), candidates.end());
+      return;
+    }
+    vertices.resize(2 * m);
+    size_t k = 0;
+    auto turnsLeft = [&](geometry::Point<T> P) {
+      return (vertices[k - 1] - vertices[k - 2]) % (P - vertices[k - 2]) > 0;
+    };
+    for (size_t i = 0; i < m; ++i) {
+      while (k >= 2 && !turnsLeft(candidates[i]))
+        --k;
+      vertices[k++] = candidates[i];
+    }
+    for (size_t i = m - 1, lower = k + 1; i-- > 0;) {
+      while (k >= lower && !turnsLeft(candidates[i]))
+        --k;
+      vertices[k++] = candidates[i];
+    }
+    vertices.resize(k - 1);
+  }
+
+  std::vector<geometry::Point<T>> vertices;
+  std::array<geometry::Point<T>, 8> extremes;
+  uint64_t seen = 0, survivors = 0;
+};
+
+// Counts of the streamed points in the cells of a grid
+// of columns x rows equal cells over the box [lo, hi];
+// points outside the box are counted in the nearest cell.
+//
+// A BoundingBoxStage pass followed by a GridBucketStage pass
+// gives bucket sizes, e.g. for splitting the input into
+// spatial partitions which fit in memory.
+template <typename T>
+class GridBucketStage {
+public:
+  GridBucketStage(geometry::Point<T> lo, geometry::Point<T> hi,
+                  uint32_t columns, uint32_t rows)
+      : lower(lo), upper(hi), columns(std::max(columns, 1u)),
+        rows(std::max(rows, 1u)), buckets(size_t(this->columns) * this->rows) {}
+
+  void operator()(const geometry::Point<T> *points, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+      ++buckets[cell(points[i])];
+  }
+
+  // Index of the cell of P: row * columns + column.
+  size_t cell(geometry::Point<T> P) const {
+    uint32_t column = axisCell(P.x(), lower.x(), upper.x(), columns);
+    uint32_t row = axisCell(P.y(), lower.y(), upper.y(), rows);
+    return size_t(row) * columns + column;
+  }
+
+  // Point counts by cell index.
+  const std::vector<uint64_t> &counts() const { return buckets; }
+
+private:
+  // The cell of v among cells equal parts of [lo, hi],
+  // computed exactly for integral coordinates.
+  static uint32_t axisCell(T v, T lo, T hi, uint32_t cells) {
+    if (v <= lo)
+      return 0;
+    if (v >= hi)
+      return cells - 1;
+    if constexpr (std::is_integral<T>::value) {
+      using Wide = unsigned __int128;
+      Wide offset = static_cast<uint64_t>(v) - static_cast<uint64_t>(lo);
+      Wide span = Wide(static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo));
+      return static_cast<uint32_t>(offset * cells / (span + 1));
+    } else {
+      long double position = static_cast<long double>(v - lo) /
+                             static_cast<long double>(hi - lo) * cells;
+      return std::min(static_cast<uint32_t>(position), cells - 1);
+    }
+  }
+
+  geometry::Point<T> lower, upper;
+  uint32_t columns, rows;
+  std::vector<uint64_t> buckets;
+};
+
+} // namespace io
+} // namespace acmlib
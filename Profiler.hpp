@@ -0,0 +1,231 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace acmlib {
+namespace profiling {
+
+// A lightweight profiler for local runs.
+//
+//   PROFILE_SCOPE("dp") times the rest of the enclosing block,
+//   PROFILE_COUNT("relaxations", k) adds k to a counter.
+//
+// Every thread accumulates into its own table, without locks;
+// tables are merged when threads exit. After a call to
+// reportAtExit, the totals are printed to stderr at program
+// exit, once thread pools created during the run have joined
+// their workers. Time is measured
+// in TSC ticks on x86 and converted to seconds against
+// std::chrono::steady_clock; a timed scope costs a few
+// dozen cycles. Times of nested scopes are inclusive.
+
+// Accumulated statistics of one name.
+struct Entry {
+  uint64_t calls = 0;
+  uint64_t ticks = 0;
+  uint64_t count = 0;
+};
+
+// A timestamp in ticks.
+inline uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __builtin_ia32_rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+// Totals over all threads, reported at program exit.
+class Registry {
+public:
+  // Never destroyed, so that threads exiting late
+  // still have a registry to merge into.
+  static Registry &global() {
+    static Registry *registry = new Registry;
+    return *registry;
+  }
+
+  Registry(const Registry &) = delete;
+  Registry &operator=(const Registry &) = delete;
+
+  // Adds statistics of a thread.
+  void merge(const std::unordered_map<const char *, Entry> &entries) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &[name, entry] : entries) {
+      if (!entry.calls && !entry.count)
+        continue;
+      Entry &total = totals[name];
+      total.calls += entry.calls;
+      total.ticks += entry.ticks;
+      total.count += entry.count;
+    }
+  }
+
+  // The merged statistics by name.
+  std::map<std::string, Entry> snapshot() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return totals;
+  }
+
+  // Seconds per tick, measured since the registry was created.
+  double secondsPerTick() const {
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - startTime)
+                         .count();
+    uint64_t elapsed = ticks() - startTicks;
+    return elapsed ? seconds / static_cast<double>(elapsed) : 0;
+  }
+
+  // Prints timers by decreasing total time, then counters,
+  // if anything was profiled.
+  void report(std::FILE *file) {
+    std::map<std::string, Entry> entries = snapshot();
+    if (entries.empty())
+      return;
+    double scale = secondsPerTick();
+    double wall = static_cast<double>(ticks() - startTicks) * scale;
+    std::vector<std::pair<std::string, Entry>> timers, counters;
+    for (const auto &named : entries)
+      (named.second.calls ? timers : counters).push_back(named);
+    std::sort(timers.begin(), timers.end(), [](const auto &a, const auto &b) {
+      return a.second.ticks > b.second.ticks;
+    });
+    std::fprintf(file, "profile: %.3f ms since the first profiled event\n",
+                 wall * 1e3);
+    if (!timers.empty())
+      std::fprintf(file, "  %-32s %12s %12s %12s %7s\n", "scope", "calls",
+                   "total ms", "average us", "%");
+    for (const auto &[name, entry] : timers) {
+      double seconds = static_cast<double>(entry.ticks) * scale;
+      std::fprintf(file, "  %-32s %12llu %12.3f %12.3f %6.1f%%\n",
+                   name.c_str(), static_cast<unsigned long long>(entry.calls),
+                   seconds * 1e3, seconds * 1e6 / entry.calls,
+                   wall > 0 ? 100 * seconds / wall : 0.0);
+    }
+    if (!counters.empty())
+      std::fprintf(file, "  %-32s %12s\n", "counter", "count");
+    for (const auto &[name, entry] : counters)
+      std::fprintf(file, "  %-32s %12llu\n", name.c_str(),
+                   static_cast<unsigned long long>(entry.count));
+  }
+
+private:
+  Registry()
+      : startTime(std::chrono::steady_clock::now()), startTicks(ticks()) {}
+
+  std::mutex mutex;
+  std::map<std::string, Entry> totals;
+  std::chrono::steady_clock::time_point startTime;
+  uint64_t startTicks;
+};
+
+// Statistics of the calling thread, keyed by the addresses
+// of the name literals and merged into the registry
+// when the thread exits.
+class ThreadProfile {
+public:
+  static ThreadProfile &local() {
+    static thread_local ThreadProfile profile;
+    return profile;
+  }
+
+  ThreadProfile(const ThreadProfile &) = delete;
+  ThreadProfile &operator=(const ThreadProfile &) = delete;
+
+  ~ThreadProfile() { flush(); }
+
+  // The entry of a name; references stay valid
+  // for the lifetime of the thread.
+  Entry &entry(const char *name) { return entries[name]; }
+
+  // Moves the statistics so far into the registry.
+  void flush() {
+    registry.merge(entries);
+    for (auto &named : entries)
+      named.second = Entry();
+  }
+
+private:
+  ThreadProfile() : registry(Registry::global()) {}
+
+  Registry &registry;
+  std::unordered_map<const char *, Entry> entries;
+};
+
+// Adds the time of its own lifetime to an entry.
+class ScopedTimer {
+public:
+  explicit ScopedTimer(Entry &entry) : entry(entry), start(ticks()) {}
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+  ~ScopedTimer() {
+    entry.ticks += ticks() - start;
+    ++entry.calls;
+  }
+
+private:
+  Entry &entry;
+  uint64_t start;
+};
+
+namespace detail {
+
+// Prints the report when destroyed, if enabled. The one
+// instance is constructed before main, so it is destroyed
+// after the static objects created while the program ran,
+// thread pools among them, and after the thread local
+// statistics of the main thread were merged.
+struct ReportAtExit {
+  ReportAtExit() { Registry::global(); }
+  ~ReportAtExit() {
+    if (enabled)
+      Registry::global().report(stderr);
+  }
+
+  bool enabled = false;
+};
+
+inline ReportAtExit atExit;
+
+} // namespace detail
+
+// Prints the totals to stderr at program exit.
+inline void reportAtExit() { detail::atExit.enabled = true; }
+
+} // namespace profiling
+} // namespace acmlib
+
+#define ACMLIB_PROFILE_CONCAT2(a, b) a##b
+#define ACMLIB_PROFILE_CONCAT(a, b) ACMLIB_PROFILE_CONCAT2(a, b)
+
+// Times the rest of the enclosing block under the given name,
+// which must be a string literal.
+#define PROFILE_SCOPE(name)                                                    \
+  static thread_local acmlib::profiling::Entry &ACMLIB_PROFILE_CONCAT(         \
+      profileEntry, __LINE__) =                                                \
+      acmlib::profiling::ThreadProfile::local().entry(name);                   \
+  acmlib::profiling::ScopedTimer ACMLIB_PROFILE_CONCAT(profileTimer,          \
+                                                       __LINE__)(              \
+      ACMLIB_PROFILE_CONCAT(profileEntry, __LINE__))
+
+// Adds k to the counter with the given name,
+// which must be a string literal.
+#define PROFILE_COUNT(name, k)                                                 \
+  do {                                                                         \
+    static thread_local acmlib::profiling::Entry &profileCounter =             \
+        acmlib::profiling::ThreadProfile::local().entry(name);                 \
+    profileCounter.count += (k);                                               \
+  } while (0)
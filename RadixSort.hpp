@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Arena.hpp"
+#include "Parallel.hpp"
+
+namespace acmlib {
+namespace algorithm {
+
+namespace detail {
+
+// Below this many elements per chunk, extra chunks
+// cost more to schedule than they save.
+constexpr size_t radixSortGrain = 1 << 14;
+
+// The number of chunks to split n elements into:
+// at most the requested number, 0 meaning one per thread
+// of the global pool.
+inline size_t radixSortThreads(size_t n, size_t threads) {
+  if (threads == 0)
+    threads = parallel::ThreadPool::global().size();
+  return std::max<size_t>(std::min(threads, n / radixSortGrain), 1);
+}
+
+// Calls f(begin, end, t) for the t-th of chunks contiguous
+// chunks of [0, n) on the global thread pool; a single chunk
+// runs on the calling thread without touching the pool.
+template <typename F>
+void forEachChunk(size_t n, size_t chunks, F f) {
+  if (chunks == 1) {
+    f(0, n, 0);
+    return;
+  }
+  parallel::parallelFor(0, chunks, [&](size_t begin, size_t end) {
+    for (size_t t = begin; t < end; ++t)
+      f(n * t / chunks, n * (t + 1) / chunks, t);
+  });
+}
+
+// An element's key together with either the element itself,
+// if it is small and trivially copyable, or its original position.
+// Carrying small elements through the passes avoids
+// a final gather with random memory accesses.
+template <typename Value>
+constexpr bool radixSortCarriesValue =
+    std::is_trivially_copyable<Value>::value &&
+    sizeof(Value) <= 2 * sizeof(uint64_t);
+
+template <typename Value>
+struct KeyedItem {
+  using Payload =
+      std::conditional_t<radixSortCarriesValue<Value>, Value, size_t>;
+  uint64_t key;
+  Payload payload;
+};
+
+} // namespace detail
+
+// Stably sorts n values by an unsigned 64-bit key
+// computed once per value by key(value).
+//
+// LSD radix sort with 8-bit digits. Digits on which
+// all keys agree are skipped, so keys using few bits
+// take few passes. Each pass is split into chunks run
+// by the global thread pool (threads = 0 means one chunk
+// per pool thread): every chunk is counted separately,
+// and the prefix sums make the scatter of different
+// chunks independent.
+//
+// Small trivially copyable values are moved along with
+// the keys, others only once, after the keys are sorted.
+// Scratch buffers come from the thread's memory::Arena,
+// so repeated sorts do not touch the heap.
+template <typename Value, typename Key>
+void radixSortByKey(Value *values, size_t n, Key key, size_t threads = 1) {
+  using Item = detail::KeyedItem<Value>;
+  constexpr bool carry = detail::radixSortCarriesValue<Value>;
+  threads = detail::radixSortThreads(n, threads);
+  memory::Arena &arena = memory::Arena::local();
+  memory::Arena::Scope scope(arena);
+  std::pmr::vector<Item> items(n, &arena), buffer(n, &arena);
+  std::pmr::vector<uint64_t> differing(threads, &arena);
+  uint64_t first = n ? static_cast<uint64_t>(key(values[0])) : 0;
+  detail::forEachChunk(n, threads, [&](size_t begin, size_t end, size_t t) {
+    for (size_t i = begin; i < end; ++i) {
+      items[i].key = static_cast<uint64_t>(key(values[i]));
+      if constexpr (carry)
+        items[i].payload = values[i];
+      else
+        items[i].payload = i;
+      differing[t] |= items[i].key ^ first;
+    }
+  });
+  uint64_t mask = 0;
+  for (uint64_t bits : differing)
+    mask |= bits;
+
+  std::pmr::vector<std::array<size_t, 256>> offsets(threads, &arena);
+  for (int shift = 0; shift < 64; shift += 8) {
+    if (!((mask >> shift) & 0xff))
+      continue;
+    const Item *from = items.data();
+    Item *to = buffer.data();
+    detail::forEachChunk(n, threads, [&](size_t begin, size_t end, size_t t) {
+      size_t *count = offsets[t].data();
+      std::fill(count, count + 256, 0);
+      for (size_t i = begin; i < end; ++i)
+        ++count[(from[i].key >> shift) & 0xff];
+    });
+    size_t position = 0;
+    for (size_t digit = 0; digit < 256; ++digit) {
+      for (size_t t = 0; t < threads; ++t) {
+        size_t count = offsets[t][digit];
+        offsets[t][digit] = position;
+        position += count;
+      }
+    }
+    detail::forEachChunk(n, threads, [&](size_t begin, size_t end, size_t t) {
+      size_t *offset = offsets[t].data();
+      for (size_t i = begin; i < end; ++i)
+        to[offset[(from[i].key >> shift) & 0xff]++] = from[i];
+    });
+    items.swap(buffer);
+  }
+
+  if constexpr (carry) {
+    detail::forEachChunk(n, threads, [&](size_t begin, size_t end, size_t) {
+      for (size_t i = begin; i < end; ++i)
+        values[i] = items[i].payload;
+    });
+  } else {
+    std::pmr::vector<Value> sorted(&arena);
+    sorted.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+      sorted.push_back(std::move(values[items[i].payload]));
+    std::move(sorted.begin(), sorted.end(), values);
+  }
+}
+
+// Overload for std::vector.
+template <typename Value, typename Key>
+void radixSortByKey(std::vector<Value> &values, Key key, size_t threads = 1) {
+  radixSortByKey(values.data(), values.size(), key, threads);
+}
+
+} // namespace algorithm
+} // namespace acmlib
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <cctype>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace acmlib {
+namespace numeric {
+
+namespace detail {
+
+// True for built-in integer types, including __int128
+// even in strict standard modes.
+template <typename I>
+constexpr bool isBuiltinInteger =
+    std::is_integral<I>::value || std::is_same<I, __int128>::value ||
+    std::is_same<I, unsigned __int128>::value;
+
+// Checked arithmetic: returns true iff the result overflowed.
+//
+// Non-builtin integer types (e.g. BigInt) must provide
+// static addOverflow and mulOverflow with the same contract.
+template <typename I>
+constexpr bool addOverflow(I a, I b, I &result) {
+  if constexpr (isBuiltinInteger<I>)
+    return __builtin_add_overflow(a, b, &result);
+  else
+    return I::addOverflow(a, b, result);
+}
+template <typename I>
+constexpr bool mulOverflow(I a, I b, I &result) {
+  if constexpr (isBuiltinInteger<I>)
+    return __builtin_mul_overflow(a, b, &result);
+  else
+    return I::mulOverflow(a, b, result);
+}
+
+// Greatest common divisor of |a| and |b|.
+//
+// std::gcd is not used since it does not accept
+// __int128 in strict modes nor user-defined integers.
+template <typename I>
+constexpr I gcd(I a, I b) {
+  if (a < 0)
+    a = -a;
+  if (b < 0)
+    b = -b;
+  while (b != 0) {
+    I r = a % b;
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
+// Floor division of a by b > 0 with a non-negative remainder.
+//
+// Unlike computing a - floor(a / b) * b, never overflows.
+template <typename I>
+constexpr void floorDivMod(I a, I b, I &quotient, I &remainder) {
+  quotient = a / b;
+  remainder = a % b;
+  if (remainder < 0) {
+    quotient -= 1;
+    remainder += b;
+  }
+}
+
+// Stream output of integers, extended to __int128
+// which has no standard stream operators.
+template <typename I>
+void writeInteger(std::ostream &os, I x) {
+  if constexpr (std::is_same<I, __int128>::value) {
+    char buffer[48], *end = buffer + sizeof(buffer), *p = end;
+    unsigned __int128 magnitude = x < 0 ? -(unsigned __int128)x : x;
+    do {
+      *--p = static_cast<char>('0' + magnitude % 10);
+      magnitude /= 10;
+    } while (magnitude);
+    if (x < 0)
+      *--p = '-';
+    os.write(p, end - p);
+  } else {
+    os << x;
+  }
+}
+
+// Stream input of integers, extended to __int128.
+template <typename I>
+void readInteger(std::istream &is, I &x) {
+  if constexpr (std::is_same<I, __int128>::value) {
+    is >> std::ws;
+    bool negative = is.peek() == '-';
+    if (negative)
+      is.get();
+    if (!std::isdigit(is.peek())) {
+      is.setstate(std::ios::failbit);
+      return;
+    }
+    x = 0;
+    while (std::isdigit(is.peek()))
+      x = x * 10 + (is.get() - '0');
+    if (negative)
+      x = -x;
+  } else {
+    is >> x;
+  }
+}
+
+} // namespace detail
+
+// An exact rational number p / q with integers of type I.
+//
+// I may be any signed integer type: int64_t, __int128
+// or a big integer implementing the usual operators.
+//
+// Fractions are kept with a positive denominator,
+// but are NOT reduced after every operation:
+// the gcd is computed only when a built-in operation
+// would overflow, or on explicit request.
+// If a value does not fit into I even after reduction,
+// std::overflow_error is thrown, so results are either
+// exact or not produced at all.
+template <typename I>
+class Rational {
+  I num;
+  I den;
+
+  [[noreturn]] static void overflow() {
+    throw std::overflow_error("acmlib::numeric::Rational overflow");
+  }
+
+public:
+  // Default constructor: zero.
+  constexpr Rational() : num(0), den(1) {}
+
+  // Construct from an integer.
+  template <typename J,
+            typename = std::enable_if_t<std::is_convertible<J, I>::value &&
+                                        !std::is_floating_point<J>::value>>
+  constexpr Rational(J x) : num(static_cast<I>(x)), den(1) {}
+
+  // Construct the fraction p / q, q != 0.
+  constexpr Rational(I p, I q) : num(p), den(q) {
+    if (den < 0) {
+      num = -num;
+      den = -den;
+    }
+  }
+
+  // Conversion between rationals with different integer types.
+  template <typename J>
+  constexpr explicit Rational(Rational<J> other)
+      : num(static_cast<I>(other.numerator())),
+        den(static_cast<I>(other.denominator())) {}
+
+  // Reduce the fraction in place.
+  constexpr Rational &normalize() {
+    I g = detail::gcd(num, den);
+    if (g != 0 && g != 1) {
+      num /= g;
+      den /= g;
+    }
+    return *this;
+  }
+
+  // Numerator and denominator of the reduced fraction.
+  // The denominator is always positive.
+  constexpr I numerator() const { return Rational(*this).normalize().num; }
+  constexpr I denominator() const { return Rational(*this).normalize().den; }
+
+  // Explicit conversion to primitive types.
+  template <typename U>
+  constexpr explicit operator U() const {
+    return static_cast<U>(num) / static_cast<U>(den);
+  }
+
+  // Arithmetic operators.
+  constexpr Rational &operator+=(Rational other) {
+    return *this = add(*this, other, false);
+  }
+  constexpr Rational &operator-=(Rational other) {
+    return *this = add(*this, other, true);
+  }
+  constexpr Rational &operator*=(Rational other) {
+    I p, q;
+    if (!detail::mulOverflow(num, other.num, p) &&
+        !detail::mulOverflow(den, other.den, q)) {
+      num = p;
+      den = q;
+      return *this;
+    }
+    // Cancel crosswise, which gives a reduced result
+    // out of reduced operands.
+    normalize();
+    other.normalize();
+    I g1 = detail::gcd(num, other.den), g2 = detail::gcd(other.num, den);
+    if (detail::mulOverflow(num / g1, other.num / g2, p) ||
+        detail::mulOverflow(den / g2, other.den / g1, q))
+      overflow();
+    num = p;
+    den = q;
+    return *this;
+  }
+  constexpr Rational &operator/=(Rational other) {
+    return *this *= other.inverse();
+  }
+  constexpr friend Rational operator+(Rational lhs, Rational rhs) {
+    return lhs += rhs;
+  }
+  constexpr friend Rational operator-(Rational lhs, Rational rhs) {
+    return lhs -= rhs;
+  }
+  constexpr friend Rational operator*(Rational lhs, Rational rhs) {
+    return lhs *= rhs;
+  }
+  constexpr friend Rational operator/(Rational lhs, Rational rhs) {
+    return lhs /= rhs;
+  }
+  constexpr Rational operator+() const { return *this; }
+  constexpr Rational operator-() const {
+    Rational result = *this;
+    result.num = -result.num;
+    return result;
+  }
+
+  // 1 / x for x != 0.
+  constexpr Rational inverse() const { return Rational(den, num); }
+
+  // Comparison operators.
+  //
+  // Fractions are cross-multiplied when it fits into I,
+  // otherwise compared by their continued fraction expansions,
+  // which never overflows.
+  constexpr friend bool operator==(Rational lhs, Rational rhs) {
+    if (lhs.den == rhs.den)
+      return lhs.num == rhs.num;
+    return compare(lhs, rhs) == 0;
+  }
+  constexpr friend bool operator!=(Rational lhs, Rational rhs) {
+    return !(lhs == rhs);
+  }
+  constexpr friend bool operator<(Rational lhs, Rational rhs) {
+    return compare(lhs, rhs) < 0;
+  }
+  constexpr friend bool operator>(Rational lhs, Rational rhs) {
+    return compare(lhs, rhs) > 0;
+  }
+  constexpr friend bool operator<=(Rational lhs, Rational rhs) {
+    return compare(lhs, rhs) <= 0;
+  }
+  constexpr friend bool operator>=(Rational lhs, Rational rhs) {
+    return compare(lhs, rhs) >= 0;
+  }
+
+  // I/O stream operators.
+  //
+  // In the stream a rational is represented as p/q,
+  // or just p if q = 1. The output is always reduced.
+  friend std::istream &operator>>(std::istream &is, Rational &x) {
+    I p, q = 1;
+    detail::readInteger(is, p);
+    if (is.peek() == '/') {
+      is.get();
+      detail::readInteger(is, q);
+    }
+    x = Rational(p, q);
+    return is;
+  }
+  friend std::ostream &operator<<(std::ostream &os, Rational x) {
+    x.normalize();
+    detail::writeInteger(os, x.num);
+    if (x.den != 1) {
+      os << '/';
+      detail::writeInteger(os, x.den);
+    }
+    return os;
+  }
+
+private:
+  // lhs + rhs, or lhs - rhs if subtract is set.
+  static constexpr Rational add(Rational lhs, Rational rhs, bool subtract) {
+    if (subtract)
+      rhs.num = -rhs.num;
+    I p, q;
+    if (lhs.den == rhs.den) {
+      if (!detail::addOverflow(lhs.num, rhs.num, p))
+        return Rational(p, lhs.den);
+    } else {
+      I x, y;
+      if (!detail::mulOverflow(lhs.num, rhs.den, x) &&
+          !detail::mulOverflow(rhs.num, lhs.den, y) &&
+          !detail::addOverflow(x, y, p) &&
+          !detail::mulOverflow(lhs.den, rhs.den, q))
+        return Rational(p, q);
+    }
+    // Slow path: reduce, then work with lcm of denominators.
+    lhs.normalize();
+    rhs.normalize();
+    I g = detail::gcd(lhs.den, rhs.den);
+    I x, y;
+    if (detail::mulOverflow(lhs.num, rhs.den / g, x) ||
+        detail::mulOverflow(rhs.num, lhs.den / g, y) ||
+        detail::addOverflow(x, y, p))
+      overflow();
+    I g2 = detail::gcd(p, g);
+    if (detail::mulOverflow(lhs.den / g2, rhs.den / g, q))
+      overflow();
+    return Rational(p / g2, q);
+  }
+
+  // Sign of lhs - rhs.
+  static constexpr int compare(Rational lhs, Rational rhs) {
+    I x, y;
+    if (!detail::mulOverflow(lhs.num, rhs.den, x) &&
+        !detail::mulOverflow(rhs.num, lhs.den, y))
+      return x < y ? -1 : (y < x ? 1 : 0);
+    // Compare integer parts, then the inverted fractional parts.
+    int sign = 1;
+    while (true) {
+      I p, q;
+      detail::floorDivMod(lhs.num, lhs.den, p, lhs.num);
+      detail::floorDivMod(rhs.num, rhs.den, q, rhs.num);
+      if (p != q)
+        return p < q ? -sign : sign;
+      if (lhs.num == 0 || rhs.num == 0) {
+        if (lhs.num == rhs.num)
+          return 0;
+        return lhs.num == 0 ? -sign : sign;
+      }
+      lhs = lhs.inverse();
+      rhs = rhs.inverse();
+      sign = -sign;
+    }
+  }
+};
+
+// Type aliases for common integer types.
+using LRational = Rational<int64_t>;
+using XRational = Rational<__int128>;
+
+// Absolute value.
+template <typename I>
+constexpr Rational<I> abs(Rational<I> x) {
+  return x < 0 ? -x : x;
+}
+
+} // namespace numeric
+} // namespace acmlib
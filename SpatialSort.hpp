@@ -0,0 +1,324 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+#include "Geometry.hpp"
+#include "GeometryBulk.hpp"
+#include "RadixSort.hpp"
+
+namespace acmlib {
+namespace geometry {
+
+// Space-filling curves for spatialSort.
+enum class Curve {
+  // Hilbert curve: consecutive cells are always adjacent,
+  // best locality.
+  Hilbert,
+  // Z-order curve: bit interleaving, cheaper keys
+  // but occasional long jumps.
+  Morton,
+};
+
+// Position of the cell (x, y) of the 2^32 x 2^32 grid
+// along the Z-order curve.
+constexpr uint64_t mortonIndex(uint32_t x, uint32_t y) {
+  auto spread = [](uint64_t v) {
+    v = (v | (v << 16)) & 0x0000ffff0000ffffull;
+    v = (v | (v << 8)) & 0x00ff00ff00ff00ffull;
+    v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0full;
+    v = (v | (v << 2)) & 0x3333333333333333ull;
+    v = (v | (v << 1)) & 0x5555555555555555ull;
+    return v;
+  };
+  return spread(x) | (spread(y) << 1);
+}
+
+namespace detail {
+
+// The Hilbert curve as a state machine over 4-bit chunks
+// of both coordinates, from the most significant ones.
+//
+// The state (bit 0: complement, bit 1: swap) is the
+// orientation of the current sub-square. An entry for a state
+// and a chunk pair (x << 4 | y) holds the 8 bits of the index
+// in the low byte and the next state in the high byte.
+constexpr std::array<std::array<uint16_t, 256>, 4> makeHilbertTable() {
+  std::array<std::array<uint16_t, 256>, 4> table{};
+  for (uint32_t state = 0; state < 4; ++state) {
+    for (uint32_t xy = 0; xy < 256; ++xy) {
+      uint32_t complement = state & 1, swap = state >> 1, digits = 0;
+      for (int bit = 3; bit >= 0; --bit) {
+        uint32_t bx = (xy >> (4 + bit)) & 1, by = (xy >> bit) & 1;
+        uint32_t rx = (swap ? by : bx) ^ complement;
+        uint32_t ry = (swap ? bx : by) ^ complement;
+        digits = digits << 2 | ((3 * rx) ^ ry);
+        if (ry == 0) {
+          complement ^= rx;
+          swap ^= 1;
+        }
+      }
+      table[state][xy] = static_cast<uint16_t>(
+          digits | (complement | swap << 1) << 8);
+    }
+  }
+  return table;
+}
+
+inline constexpr std::array<std::array<uint16_t, 256>, 4> hilbertTable =
+    makeHilbertTable();
+
+} // namespace detail
+
+// Position of the cell (x, y) of the 2^32 x 2^32 grid
+// along the Hilbert curve starting at (0, 0) and
+// ending at (2^32 - 1, 0).
+constexpr uint64_t hilbertIndex(uint32_t x, uint32_t y) {
+  uint64_t d = 0;
+  uint32_t state = 0;
+  for (int shift = 28; shift >= 0; shift -= 4) {
+    uint32_t xy = ((x >> shift) & 15) << 4 | ((y >> shift) & 15);
+    uint16_t entry = detail::hilbertTable[state][xy];
+    d = d << 8 | (entry & 0xff);
+    state = entry >> 8;
+  }
+  return d;
+}
+
+namespace detail {
+
+// Maps coordinates into cells of the 2^32 x 2^32 grid
+// covering the bounding box of the points.
+//
+// Both axes use the same scale, so cells are squares
+// and curve neighbours are geometric neighbours.
+template <typename T>
+class GridMapper {
+public:
+  // Grid over the bounding box with corners lo and hi.
+  GridMapper(Point<T> lo, Point<T> hi) : origin(lo) {
+    if constexpr (exactShift) {
+      uint64_t span = std::max(offset(hi.x(), lo.x()), offset(hi.y(), lo.y()));
+      while (shift < 64 && (span >> shift) > 0xffffffffull)
+        ++shift;
+    } else {
+      long double span = std::max(static_cast<long double>(hi.x() - lo.x()),
+                                  static_cast<long double>(hi.y() - lo.y()));
+      scale = span > 0 ? 4294967295.0l / span : 0;
+    }
+  }
+
+  // The cell of the point P.
+  void operator()(Point<T> P, uint32_t &x, uint32_t &y) const {
+    if constexpr (exactShift) {
+      x = static_cast<uint32_t>(offset(P.x(), origin.x()) >> shift);
+      y = static_cast<uint32_t>(offset(P.y(), origin.y()) >> shift);
+    } else {
+      x = cell(P.x() - origin.x());
+      y = cell(P.y() - origin.y());
+    }
+  }
+
+private:
+  // Integer coordinates up to 64 bits are mapped exactly
+  // by a shift, others through long double.
+  static constexpr bool exactShift =
+      std::is_integral<T>::value && sizeof(T) <= sizeof(uint64_t);
+
+  // a - b for a >= b, computed without overflow.
+  static uint64_t offset(T a, T b) {
+    return static_cast<uint64_t>(a) - static_cast<uint64_t>(b);
+  }
+
+  uint32_t cell(T delta) const {
+    long double v = static_cast<long double>(delta) * scale;
+    return static_cast<uint32_t>(std::min(std::max(v, 0.0l), 4294967295.0l));
+  }
+
+  Point<T> origin;
+  int shift = 0;
+  long double scale = 0;
+};
+
+} // namespace detail
+
+// Reorders n points along a space-filling curve,
+// so that points close in the array are close in the plane.
+//
+// Running Delaunay triangulation, k-d tree construction or
+// nearest neighbour queries on spatially sorted input makes
+// their memory accesses local and greatly improves cache hits.
+//
+// Keys are computed on the 2^32 x 2^32 grid over the bounding box
+// and sorted by radixSortByKey with the given number of threads
+// (0 means all threads of the global pool). Points in the same cell
+// keep their relative order.
+template <typename T>
+void spatialSort(Point<T> *points, size_t n, Curve curve = Curve::Hilbert,
+                 size_t threads = 1) {
+  if (n < 2)
+    return;
+  Point<T> lo, hi;
+  if (threads == 1)
+    boundingBox<Execution::Sequential>(points, n, lo, hi);
+  else
+    boundingBox<Execution::Parallel>(points, n, lo, hi);
+  detail::GridMapper<T> mapper(lo, hi);
+  if (curve == Curve::Hilbert) {
+    algorithm::radixSortByKey(
+        points, n,
+        [&](Point<T> P) {
+          uint32_t x, y;
+          mapper(P, x, y);
+          return hilbertIndex(x, y);
+        },
+        threads);
+  } else {
+    algorithm::radixSortByKey(
+        points, n,
+        [&](Point<T> P) {
+          uint32_t x, y;
+          mapper(P, x, y);
+          return mortonIndex(x, y);
+        },
+        threads);
+  }
+}
+
+// Overload for std::vector.
+template <typename T>
+void spatialSort(std::vector<Point<T>> &points, Curve curve = Curve::Hilbert,
+                 size_t threads = 1) {
+  spatialSort(points.data(), points.size(), curve, threads);
+}
+
+namespace detail {
+
+// An unsigned key ordered as the coordinate x: the sign bit
+// flipped for signed integers; for doubles the IEEE 754 bits,
+// complemented for negative values, with -0.0 mapped
+// to the key of 0.0 since the two compare equal.
+template <typename T>
+inline uint64_t orderedKey(T x) {
+  if constexpr (std::is_integral<T>::value) {
+    if constexpr (std::is_signed<T>::value)
+      return static_cast<uint64_t>(static_cast<int64_t>(x)) ^ (1ull << 63);
+    else
+      return static_cast<uint64_t>(x);
+  } else {
+    double canonical = x == 0 ? 0.0 : x;
+    uint64_t bits;
+    std::memcpy(&bits, &canonical, sizeof(bits));
+    return bits >> 63 ? ~bits : bits | (1ull << 63);
+  }
+}
+
+// The integral coordinate with the given orderedKey.
+template <typename T>
+inline T fromOrderedKey(uint64_t key) {
+  if constexpr (std::is_signed<T>::value)
+    return static_cast<T>(static_cast<int64_t>(key ^ (1ull << 63)));
+  else
+    return static_cast<T>(key);
+}
+
+// The number of bits needed to represent v.
+inline int bitWidth(uint64_t v) { return v ? 64 - __builtin_clzll(v) : 0; }
+
+// Stably sorts every run of points with equal x by y.
+template <typename T>
+void sortEqualRunsByY(Point<T> *points, size_t n) {
+  for (size_t begin = 0, end; begin < n; begin = end) {
+    for (end = begin + 1; end < n && points[end].x() == points[begin].x();)
+      ++end;
+    if (end - begin > 1)
+      std::stable_sort(points + begin, points + end,
+                       [](Point<T> P, Point<T> Q) { return P.y() < Q.y(); });
+  }
+}
+
+} // namespace detail
+
+// Sorts n points lexicographically, by x and then by y:
+// the order of std::stable_sort with Vector's operator<,
+// for integral or double coordinates (not NaN).
+//
+// LSD radix sort by radixSortByKey with the given number
+// of threads (0 means all threads of the global pool)
+// on order-preserving keys of the coordinates. When
+// the offsets of both coordinates from the bounding box
+// fit together in 64 bits, as for IPoint or LPoint with
+// coordinates below 2^31, they form a single key.
+// Otherwise, as for doubles, points are sorted by x
+// and runs of equal x are then sorted by y, which is
+// cheaper than a second radix sort when ties are rare.
+//
+// Single keys of integral points with small spans take few
+// passes and beat std::sort; double keys vary in all 8 digits
+// and may not, measure with BM_GeometryLexicographicSort.
+template <typename T>
+void lexicographicSort(Point<T> *points, size_t n, size_t threads = 1) {
+  static_assert(std::is_integral<T>::value || std::is_same<T, double>::value,
+                "lexicographicSort needs integral or double coordinates");
+  using detail::fromOrderedKey;
+  using detail::orderedKey;
+  if (n < 2)
+    return;
+  if constexpr (std::is_integral<T>::value) {
+    Point<T> lo, hi;
+    if (threads == 1)
+      boundingBox<Execution::Sequential>(points, n, lo, hi);
+    else
+      boundingBox<Execution::Parallel>(points, n, lo, hi);
+    uint64_t x0 = orderedKey(lo.x()), y0 = orderedKey(lo.y());
+    int xBits = detail::bitWidth(orderedKey(hi.x()) - x0);
+    int yBits = detail::bitWidth(orderedKey(hi.y()) - y0);
+    if (xBits + yBits <= 64 && yBits < 64) {
+      auto key = [&](Point<T> P) {
+        return (orderedKey(P.x()) - x0) << yBits | (orderedKey(P.y()) - y0);
+      };
+      if constexpr (sizeof(Point<T>) <= sizeof(uint64_t)) {
+        algorithm::radixSortByKey(points, n, key, threads);
+      } else {
+        // The key determines the point: sorting keys alone
+        // moves a third less data than keys with points.
+        memory::Arena &arena = memory::Arena::local();
+        memory::Arena::Scope scope(arena);
+        std::pmr::vector<uint64_t> keys(n, &arena);
+        size_t chunks = algorithm::detail::radixSortThreads(n, threads);
+        algorithm::detail::forEachChunk(
+            n, chunks, [&](size_t begin, size_t end, size_t) {
+              for (size_t i = begin; i < end; ++i)
+                keys[i] = key(points[i]);
+            });
+        algorithm::radixSortByKey(
+            keys.data(), n, [](uint64_t k) { return k; }, threads);
+        const uint64_t yMask = (1ull << yBits) - 1;
+        algorithm::detail::forEachChunk(
+            n, chunks, [&](size_t begin, size_t end, size_t) {
+              for (size_t i = begin; i < end; ++i)
+                points[i] = {fromOrderedKey<T>((keys[i] >> yBits) + x0),
+                             fromOrderedKey<T>((keys[i] & yMask) + y0)};
+            });
+      }
+      return;
+    }
+  }
+  algorithm::radixSortByKey(
+      points, n, [](Point<T> P) { return orderedKey(P.x()); }, threads);
+  detail::sortEqualRunsByY(points, n);
+}
+
+// Overload for std::vector.
+template <typename T>
+void lexicographicSort(std::vector<Point<T>> &points, size_t threads = 1) {
+  lexicographicSort(points.data(), points.size(), threads);
+}
+
+} // namespace geometry
+} // namespace acmlib
@@ -2,6 +2,8 @@
 #include <bitset>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -23,8 +25,17 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "acm/FastIO.hpp"
+#ifdef LOCAL
+#include "acm/Profiler.hpp"
+#endif
+#ifdef PARALLEL
+#include "acm/Parallel.hpp"
+#endif
+
 #define int i64
 using i32 = int32_t;
 using u32 = uint32_t;
@@ -56,11 +67,39 @@ ostream &operator<<(ostream &stream, const vector<T> &v) {
 
 } // namespace std
 
+// Under LOCAL, PROFILE_SCOPE("name") times the rest of a block
+// and PROFILE_COUNT("name", k) counts events; the totals are
+// printed to stderr at exit. Both compile to nothing otherwise.
 #ifdef LOCAL
 #include "acm/debug.hpp"
 #else
 #define DEBUG(...) ;
 #define ADEBUG(a, n) ;
+#define PROFILE_SCOPE(name) ;
+#define PROFILE_COUNT(name, k) ;
+#endif
+
+// Fast input from stdin, e.g. fastIn >> n >> point,
+// or fastIn.read(points) for a whole vector. Named to stay
+// clear of the in and out of solutions.
+acmlib::io::Reader fastIn;
+// Fast buffered output to stdout, e.g. fastOut << point << '\n',
+// flushed once at the end of main.
+acmlib::io::Writer fastOut;
+
+// Compile with -DPARALLEL for batch runs with many
+// independent test cases: read them all, then call
+// solveInParallel to use every core. The answers go
+// to fastOut, in order with the rest of the output.
+#ifdef PARALLEL
+using acmlib::parallel::parallelFor;
+using acmlib::parallel::parallelInvoke;
+using acmlib::parallel::parallelReduce;
+
+template <typename Solve>
+void solveInParallel(size_t n, Solve solve) {
+  acmlib::parallel::solveInParallel(n, solve, fastOut);
+}
 #endif
 
 void runSolution(void);
@@ -68,11 +107,14 @@ void runSolution(void);
 i32 main() {
   std::ios::sync_with_stdio(0);
   std::cin.tie(0);
-  runSolution();
 #ifdef LOCAL
-  // std::cerr << "Solution ran in " << static_cast<double>(clock()) /
-  // CLOCKS_PER_SEC << std::endl;
+  acmlib::profiling::reportAtExit();
 #endif
+  {
+    PROFILE_SCOPE("runSolution");
+    runSolution();
+  }
+  fastOut.flush();
   return 0;
 }
 /***************************************************************************/
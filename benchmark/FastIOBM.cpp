@@ -0,0 +1,166 @@
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FastIO.hpp"
+#include "Geometry.hpp"
+#include "PointFile.hpp"
+#include "PointGenerator.hpp"
+#include "PointStream.hpp"
+#include "benchmark/benchmark.h"
+
+using namespace acmlib::geometry;
+
+// Text with n points of type T, one per line.
+template <typename T>
+static std::string pointsText(size_t n) {
+  std::mt19937_64 rng(0);
+  std::uniform_int_distribution<int64_t> coordinate(-(1 << 29), 1 << 29);
+  std::ostringstream os;
+  os.precision(17);
+  for (size_t i = 0; i < n; ++i)
+    os << Vector<T>(LPoint(coordinate(rng), coordinate(rng))) / T(7) << '\n';
+  return os.str();
+}
+
+template <typename T>
+static void BM_IOReadPointsIstream(benchmark::State& state) {
+  const size_t n = 1 << 16;
+  std::string text = pointsText<T>(n);
+  std::vector<Vector<T>> points(n);
+  for (auto _ : state) {
+    std::istringstream is(text);
+    for (auto& P : points)
+      is >> P;
+    benchmark::DoNotOptimize(points.data());
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+template <typename T>
+static void BM_IOReadPointsReader(benchmark::State& state) {
+  const size_t n = 1 << 16;
+  std::string text = pointsText<T>(n);
+  std::vector<Vector<T>> points(n);
+  for (auto _ : state) {
+    acmlib::io::Reader in(text.data(), text.size());
+    in.read(points);
+    benchmark::DoNotOptimize(points.data());
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK(BM_IOReadPointsIstream<int64_t>);
+BENCHMARK(BM_IOReadPointsReader<int64_t>);
+BENCHMARK(BM_IOReadPointsIstream<double>);
+BENCHMARK(BM_IOReadPointsReader<double>);
+BENCHMARK(BM_IOReadPointsIstream<Real>);
+BENCHMARK(BM_IOReadPointsReader<Real>);
+
+template <typename T>
+static void BM_IOWritePointsOstream(benchmark::State& state) {
+  const size_t n = 1 << 16;
+  std::string text = pointsText<T>(n);
+  std::vector<Vector<T>> points(n);
+  acmlib::io::Reader(text.data(), text.size()).read(points);
+  for (auto _ : state) {
+    std::ostringstream os;
+    os.precision(17);
+    for (auto P : points)
+      os << P << '\n';
+    benchmark::DoNotOptimize(os.str().data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+static void BM_IOWritePointsWriter(benchmark::State& state) {
+  const size_t n = 1 << 16;
+  std::string text = pointsText<T>(n);
+  std::vector<Vector<T>> points(n);
+  acmlib::io::Reader(text.data(), text.size()).read(points);
+  std::FILE* sink = std::fopen("/dev/null", "w");
+  for (auto _ : state) {
+    acmlib::io::Writer out(sink);
+    out.write(points.data(), n, '\n');
+  }
+  std::fclose(sink);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_IOWritePointsOstream<int64_t>);
+BENCHMARK(BM_IOWritePointsWriter<int64_t>);
+BENCHMARK(BM_IOWritePointsOstream<double>);
+BENCHMARK(BM_IOWritePointsWriter<double>);
+
+// Opening a binary point file and summing the coordinates,
+// so that every page is actually touched.
+static void BM_IOLoadPointFile(benchmark::State& state) {
+  const size_t n = 1 << 20;
+  std::vector<LPoint> points(n);
+  for (size_t i = 0; i < n; ++i)
+    points[i] = {int64_t(i), -int64_t(i)};
+  std::string path = "/tmp/acmlib-benchmark-points.bin";
+  acmlib::io::writePointFile(path, points.data(), n);
+  for (auto _ : state) {
+    acmlib::io::PointFile file(path);
+    int64_t sum = 0;
+    for (LPoint P : file.points<int64_t>())
+      sum += P.x() + P.y();
+    benchmark::DoNotOptimize(sum);
+  }
+  std::remove(path.c_str());
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_IOLoadPointFile);
+
+// Bounding box and convex hull of text points, streamed in chunks
+// of state.range(0) points with parsing on a background thread,
+// or parsed all at once and then processed (range 0).
+static void BM_IOStreamHull(benchmark::State& state) {
+  const size_t n = 1 << 20;
+  std::string text = pointsText<int64_t>(n);
+  for (auto _ : state) {
+    acmlib::io::Reader in(text.data(), text.size());
+    acmlib::io::BoundingBoxStage<int64_t> box;
+    acmlib::io::HullStage<int64_t> hull;
+    if (state.range(0) == 0) {
+      std::vector<LPoint> points(n);
+      in.read(points);
+      acmlib::io::stages(box, hull)(points.data(), n);
+    } else {
+      acmlib::io::streamPoints<int64_t>(
+          acmlib::io::ReaderSource<int64_t>(in),
+          acmlib::io::stages(box, hull), state.range(0));
+    }
+    benchmark::DoNotOptimize(hull.hull().data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_IOStreamHull)->Arg(0)->Arg(1 << 12)->Arg(1 << 16);
+
+// Convex hull of 2^20 points of the distribution D,
+// fed to HullStage in chunks of 2^16 points.
+template <Distribution D>
+static void BM_IOHullStage(benchmark::State& state) {
+  const size_t n = 1 << 20, chunk = 1 << 16;
+  std::vector<LPoint> points = generatePoints<int64_t>(D, n);
+  for (auto _ : state) {
+    acmlib::io::HullStage<int64_t> hull;
+    for (size_t i = 0; i < n; i += chunk)
+      hull(points.data() + i, chunk);
+    benchmark::DoNotOptimize(hull.hull().data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_IOHullStage<Distribution::UniformSquare>);
+BENCHMARK(BM_IOHullStage<Distribution::UniformDisk>);
+BENCHMARK(BM_IOHullStage<Distribution::GaussianClusters>);
+BENCHMARK(BM_IOHullStage<Distribution::NearlyCollinear>);
+BENCHMARK(BM_IOHullStage<Distribution::JitteredGrid>);
+BENCHMARK(BM_IOHullStage<Distribution::HullAdversarial>);
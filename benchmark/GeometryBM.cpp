@@ -1,12 +1,32 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
 #include <random>
+#include <vector>
 
+#include "Arena.hpp"
+#include "BigInt.hpp"
+#include "Fixed.hpp"
 #include "Geometry.hpp"
+#include "GeometryBulk.hpp"
+#include "IntervalReal.hpp"
+#include "PerfCounters.hpp"
+#include "PointDedup.hpp"
+#include "PointGenerator.hpp"
+#include "SpatialSort.hpp"
 #include "benchmark/benchmark.h"
 
 using namespace acmlib::geometry;
 
+// Scalar arithmetic of Real against the primitive types.
+// Hardware counters (see PerfCounters.hpp) tell whether
+// the epsilon comparisons and x87 long double operations
+// are bound by latency (low IPC) or by branch misses.
 template <typename T>
 static void BM_GeometryRealAddition(benchmark::State& state) {
+  PerfCounters counters(state);
   for (auto _ : state) {
     T x = 0;
     benchmark::DoNotOptimize(x += 3);
@@ -31,6 +51,7 @@ static void BM_GeometryRealAddition(benchmark::State& state) {
 
 template <typename T>
 static void BM_GeometryRealMultiplication(benchmark::State& state) {
+  PerfCounters counters(state);
   for (auto _ : state) {
     T x = 3, y = 4;
     benchmark::DoNotOptimize(x * y);
@@ -44,6 +65,7 @@ static void BM_GeometryRealMultiplication(benchmark::State& state) {
 
 template <typename T>
 static void BM_GeometryRealDivision(benchmark::State& state) {
+  PerfCounters counters(state);
   for (auto _ : state) {
     T x = 123;
     T y = -78.848924;
@@ -58,6 +80,7 @@ static void BM_GeometryRealDivision(benchmark::State& state) {
 
 template <typename T>
 static void BM_GeometryRealComparison(benchmark::State& state) {
+  PerfCounters counters(state);
   for (auto _ : state) {
     T x = -9.8;
     T y = 13;
@@ -70,6 +93,35 @@ static void BM_GeometryRealComparison(benchmark::State& state) {
   }
 }
 
+// The same comparisons over arrays, per element: the operator
+// in a loop (argument 0) against the compare kernel (argument 1).
+// On double arrays the kernel is vectorized when built
+// for SSE4.1 or later.
+template <typename F>
+static void BM_GeometryRealComparisonArray(benchmark::State& state) {
+  const size_t n = 1 << 12;
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> value(-1, 1);
+  std::vector<F> x(n), y(n);
+  for (size_t i = 0; i < n; ++i) {
+    x[i] = value(rng);
+    y[i] = value(rng);
+  }
+  std::vector<uint8_t> mask(n);
+  PerfCounters counters(state);
+  for (auto _ : state) {
+    if (state.range(0)) {
+      compare<Comparison::Less>(x.data(), y.data(), mask.data(), n);
+    } else {
+      for (size_t i = 0; i < n; ++i)
+        mask[i] = x[i] < y[i];
+    }
+    benchmark::DoNotOptimize(mask.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
 BENCHMARK(BM_GeometryRealAddition<long double>);
 BENCHMARK(BM_GeometryRealAddition<Real>);
 BENCHMARK(BM_GeometryRealMultiplication<long double>);
@@ -78,3 +130,565 @@ BENCHMARK(BM_GeometryRealDivision<long double>);
 BENCHMARK(BM_GeometryRealDivision<Real>);
 BENCHMARK(BM_GeometryRealComparison<long double>);
 BENCHMARK(BM_GeometryRealComparison<Real>);
+BENCHMARK(BM_GeometryRealComparisonArray<long double>)->Arg(0)->Arg(1);
+BENCHMARK(BM_GeometryRealComparisonArray<double>)->Arg(0)->Arg(1);
+BENCHMARK(BM_GeometryRealComparisonArray<Real>)->Arg(0)->Arg(1);
+BENCHMARK(BM_GeometryRealAddition<acmlib::numeric::Fixed64>);
+BENCHMARK(BM_GeometryRealMultiplication<acmlib::numeric::Fixed64>);
+BENCHMARK(BM_GeometryRealDivision<acmlib::numeric::Fixed64>);
+BENCHMARK(BM_GeometryRealComparison<acmlib::numeric::Fixed64>);
+
+template <typename T>
+static void BM_GeometryMatrixPow(benchmark::State& state) {
+  Matrix<T> m{1, 1, 1, 0};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(m);
+    benchmark::DoNotOptimize(pow(m, 60));
+  }
+}
+
+template <typename T>
+static void BM_GeometryMatrixMultiplyBatch(benchmark::State& state) {
+  const size_t n = 1 << 12;
+  std::vector<Matrix<T>> lhs(n, {1, 2, 3, 4}), rhs(n, {0, 1, -1, 2}), out(n);
+  for (auto _ : state) {
+    multiplyBatch(lhs.data(), rhs.data(), out.data(), n);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_GeometryMatrixPow<int64_t>);
+BENCHMARK(BM_GeometryMatrixPow<double>);
+BENCHMARK(BM_GeometryMatrixPow<Real>);
+BENCHMARK(BM_GeometryMatrixMultiplyBatch<int64_t>);
+BENCHMARK(BM_GeometryMatrixMultiplyBatch<double>);
+BENCHMARK(BM_GeometryMatrixMultiplyBatch<Real>);
+
+// Per-operation throughput of Geometry.hpp primitives over
+// arrays of state.range(0) elements: from arrays fitting in L1
+// to ones streaming from memory. Coordinates are integers
+// up to 2^20 in absolute value, so LVector products are exact.
+
+// Array sizes of the per-operation benchmarks.
+static void arraySizes(benchmark::internal::Benchmark* b) {
+  b->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+}
+
+// n vectors uniform in the square of side 2^21
+// with coordinates of type T.
+template <typename T>
+static std::vector<Vector<T>> randomVectors(size_t n, uint64_t seed) {
+  return generatePoints<T>(Distribution::UniformSquare, n, seed);
+}
+
+// Calls op(i) for every element in each iteration
+// and reports elements per second.
+template <typename Op>
+static void runOverArray(benchmark::State& state, Op op) {
+  const size_t n = state.range(0);
+  PerfCounters counters(state);
+  for (auto _ : state) {
+    for (size_t i = 0; i < n; ++i)
+      op(i);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+static void BM_GeometryVectorAddition(benchmark::State& state) {
+  auto a = randomVectors<T>(state.range(0), 1);
+  auto b = randomVectors<T>(state.range(0), 2);
+  std::vector<Vector<T>> out(a.size());
+  benchmark::DoNotOptimize(out.data());
+  runOverArray(state, [&](size_t i) { out[i] = a[i] + b[i]; });
+}
+
+template <typename T>
+static void BM_GeometryVectorScaling(benchmark::State& state) {
+  auto a = randomVectors<T>(state.range(0), 1);
+  std::vector<Vector<T>> out(a.size());
+  benchmark::DoNotOptimize(out.data());
+  runOverArray(state, [&](size_t i) { out[i] = a[i] * T(3); });
+}
+
+template <typename T>
+static void BM_GeometryVectorCross(benchmark::State& state) {
+  auto a = randomVectors<T>(state.range(0), 1);
+  auto b = randomVectors<T>(state.range(0), 2);
+  std::vector<T> out(a.size());
+  benchmark::DoNotOptimize(out.data());
+  runOverArray(state, [&](size_t i) { out[i] = a[i] % b[i]; });
+}
+
+// Exact cross products of compact vectors: the same number of
+// points in half or a quarter of the memory of LVector.
+template <typename T>
+static void BM_GeometryVectorWideCross(benchmark::State& state) {
+  const double radius = std::numeric_limits<T>::max() / 2;
+  auto a = generatePoints<T>(Distribution::UniformSquare, state.range(0), 1,
+                             radius);
+  auto b = generatePoints<T>(Distribution::UniformSquare, state.range(0), 2,
+                             radius);
+  std::vector<WideProduct<T>> out(a.size());
+  benchmark::DoNotOptimize(out.data());
+  runOverArray(state, [&](size_t i) { out[i] = wideCross(a[i], b[i]); });
+}
+
+template <typename T>
+static void BM_GeometryVectorDot(benchmark::State& state) {
+  auto a = randomVectors<T>(state.range(0), 1);
+  auto b = randomVectors<T>(state.range(0), 2);
+  std::vector<T> out(a.size());
+  benchmark::DoNotOptimize(out.data());
+  runOverArray(state, [&](size_t i) { out[i] = a[i] ^ b[i]; });
+}
+
+template <typename T>
+static void BM_GeometryVectorLength(benchmark::State& state) {
+  auto a = randomVectors<T>(state.range(0), 1);
+  std::vector<Real> out(a.size());
+  benchmark::DoNotOptimize(out.data());
+  runOverArray(state, [&](size_t i) { out[i] = a[i].len(); });
+}
+
+// Scaling to unit length for RVector,
+// division by the gcd for LVector.
+template <typename T>
+static void BM_GeometryVectorNormalize(benchmark::State& state) {
+  auto a = randomVectors<T>(state.range(0), 1);
+  std::vector<Vector<T>> out(a.size());
+  benchmark::DoNotOptimize(out.data());
+  runOverArray(state, [&](size_t i) { out[i] = normalized(a[i]); });
+}
+
+template <typename T>
+static void BM_GeometryMatrixVector(benchmark::State& state) {
+  auto a = randomVectors<T>(state.range(0), 1);
+  auto b = randomVectors<T>(state.range(0), 2);
+  std::vector<Vector<T>> out(a.size());
+  benchmark::DoNotOptimize(out.data());
+  runOverArray(state, [&](size_t i) {
+    out[i] = Matrix<T>(a[i].x(), a[i].y(), b[i].x(), b[i].y()) * a[i];
+  });
+}
+
+template <typename T>
+static void BM_GeometryMatrixMultiply(benchmark::State& state) {
+  auto a = randomVectors<T>(state.range(0), 1);
+  auto b = randomVectors<T>(state.range(0), 2);
+  std::vector<Matrix<T>> lhs(a.size()), rhs(a.size()), out(a.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    lhs[i] = {a[i].x(), a[i].y(), b[i].x(), b[i].y()};
+    rhs[i] = {b[i].y(), a[i].x(), b[i].x(), a[i].y()};
+  }
+  benchmark::DoNotOptimize(out.data());
+  runOverArray(state, [&](size_t i) { out[i] = lhs[i] * rhs[i]; });
+}
+
+template <typename T>
+static void BM_GeometryLineConstruction(benchmark::State& state) {
+  auto a = randomVectors<T>(state.range(0), 1);
+  auto b = randomVectors<T>(state.range(0), 2);
+  std::vector<Line<T>> out(a.size());
+  benchmark::DoNotOptimize(out.data());
+  runOverArray(state, [&](size_t i) { out[i] = Line<T>(a[i], b[i]); });
+}
+
+template <typename T>
+static void BM_GeometryLineEval(benchmark::State& state) {
+  auto a = randomVectors<T>(state.range(0), 1);
+  Line<T> l(LVector(3, -7), LVector(-11, 5));
+  std::vector<T> out(a.size());
+  benchmark::DoNotOptimize(out.data());
+  runOverArray(state, [&](size_t i) { out[i] = l.eval(a[i]); });
+}
+
+template <typename T>
+static void BM_GeometryLineRelativePosition(benchmark::State& state) {
+  auto a = randomVectors<T>(state.range(0), 1);
+  Line<T> l(LVector(3, -7), LVector(-11, 5));
+  std::vector<int32_t> out(a.size());
+  benchmark::DoNotOptimize(out.data());
+  runOverArray(state, [&](size_t i) { out[i] = l.relativePosition(a[i]); });
+}
+
+template <typename T>
+static void BM_GeometryTriangleArea(benchmark::State& state) {
+  auto a = randomVectors<T>(state.range(0) + 2, 1);
+  std::vector<Real> out(state.range(0));
+  benchmark::DoNotOptimize(out.data());
+  runOverArray(state, [&](size_t i) {
+    out[i] = triangleArea(a[i], a[i + 1], a[i + 2]);
+  });
+}
+
+BENCHMARK(BM_GeometryVectorAddition<int64_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorAddition<double>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorAddition<Real>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorScaling<int64_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorScaling<double>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorScaling<Real>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorCross<int64_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorCross<double>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorCross<Real>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorWideCross<int64_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorWideCross<int32_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorWideCross<int16_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorDot<int64_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorDot<double>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorDot<Real>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorLength<int64_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorLength<double>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorLength<Real>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorNormalize<int64_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryVectorNormalize<Real>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryMatrixVector<int64_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryMatrixVector<double>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryMatrixVector<Real>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryMatrixMultiply<int64_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryMatrixMultiply<double>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryMatrixMultiply<Real>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryLineConstruction<int64_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryLineConstruction<double>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryLineConstruction<Real>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryLineEval<int64_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryLineEval<double>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryLineEval<Real>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryLineRelativePosition<int64_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryLineRelativePosition<double>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryLineRelativePosition<Real>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryTriangleArea<int64_t>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryTriangleArea<double>)->Apply(arraySizes);
+BENCHMARK(BM_GeometryTriangleArea<Real>)->Apply(arraySizes);
+
+// Throughput of elementary function tiers over arrays,
+// with the maximum absolute error against long double libm
+// reported as a counter.
+template <Accuracy A, typename F>
+static void BM_GeometrySinCos(benchmark::State& state) {
+  const size_t n = 1 << 12;
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> angle(-100, 100);
+  std::vector<F> x(n), s(n), c(n);
+  for (auto& value : x)
+    value = angle(rng);
+  for (auto _ : state) {
+    sincos<A>(x.data(), s.data(), c.data(), n);
+    benchmark::DoNotOptimize(s.data());
+    benchmark::DoNotOptimize(c.data());
+    benchmark::ClobberMemory();
+  }
+  long double maxError = 0;
+  for (size_t i = 0; i < n; ++i) {
+    long double xi = static_cast<long double>(x[i]);
+    maxError = std::max(maxError, std::fabs(static_cast<long double>(s[i]) -
+                                            std::sin(xi)));
+    maxError = std::max(maxError, std::fabs(static_cast<long double>(c[i]) -
+                                            std::cos(xi)));
+  }
+  state.counters["max_error"] = static_cast<double>(maxError);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <Accuracy A, typename F>
+static void BM_GeometryAtan2(benchmark::State& state) {
+  const size_t n = 1 << 12;
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> coordinate(-1e3, 1e3);
+  std::vector<F> y(n), x(n), result(n);
+  for (size_t i = 0; i < n; ++i) {
+    y[i] = coordinate(rng);
+    x[i] = coordinate(rng);
+  }
+  for (auto _ : state) {
+    atan2<A>(y.data(), x.data(), result.data(), n);
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  long double maxError = 0;
+  for (size_t i = 0; i < n; ++i) {
+    long double expected = std::atan2(static_cast<long double>(y[i]),
+                                      static_cast<long double>(x[i]));
+    maxError = std::max(
+        maxError, std::fabs(static_cast<long double>(result[i]) - expected));
+  }
+  state.counters["max_error"] = static_cast<double>(maxError);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <Accuracy A>
+static void BM_GeometrySqrt(benchmark::State& state) {
+  const size_t n = 1 << 12;
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> value(0, 1e6);
+  std::vector<Real> x(n), result(n);
+  for (auto& xi : x)
+    xi = value(rng);
+  for (auto _ : state) {
+    for (size_t i = 0; i < n; ++i)
+      result[i] = sqrt<A>(x[i]);
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  long double maxError = 0;
+  for (size_t i = 0; i < n; ++i) {
+    long double expected = std::sqrt(static_cast<long double>(x[i]));
+    long double found = static_cast<long double>(result[i]);
+    maxError = std::max(maxError, std::fabs(found - expected) / expected);
+  }
+  state.counters["max_relative_error"] = static_cast<double>(maxError);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK_TEMPLATE(BM_GeometrySinCos, Accuracy::Libm, Real);
+BENCHMARK_TEMPLATE(BM_GeometrySinCos, Accuracy::Nano, Real);
+BENCHMARK_TEMPLATE(BM_GeometrySinCos, Accuracy::Micro, Real);
+BENCHMARK_TEMPLATE(BM_GeometrySinCos, Accuracy::Libm, double);
+BENCHMARK_TEMPLATE(BM_GeometrySinCos, Accuracy::Nano, double);
+BENCHMARK_TEMPLATE(BM_GeometrySinCos, Accuracy::Micro, double);
+BENCHMARK_TEMPLATE(BM_GeometryAtan2, Accuracy::Libm, Real);
+BENCHMARK_TEMPLATE(BM_GeometryAtan2, Accuracy::Nano, Real);
+BENCHMARK_TEMPLATE(BM_GeometryAtan2, Accuracy::Micro, Real);
+BENCHMARK_TEMPLATE(BM_GeometryAtan2, Accuracy::Libm, double);
+BENCHMARK_TEMPLATE(BM_GeometryAtan2, Accuracy::Nano, double);
+BENCHMARK_TEMPLATE(BM_GeometryAtan2, Accuracy::Micro, double);
+BENCHMARK(BM_GeometrySqrt<Accuracy::Libm>);
+BENCHMARK(BM_GeometrySqrt<Accuracy::Nano>);
+BENCHMARK(BM_GeometrySqrt<Accuracy::Micro>);
+
+// Exact incircle predicate on integer points,
+// with the determinant evaluated in type W.
+template <typename W>
+static void BM_GeometryInCircle(benchmark::State& state) {
+  const size_t n = 1 << 10;
+  std::mt19937_64 rng(0);
+  std::uniform_int_distribution<int64_t> coordinate(-(1 << 29), 1 << 29);
+  std::vector<LPoint> points(n + 3);
+  for (auto& P : points)
+    P = {coordinate(rng), coordinate(rng)};
+  for (auto _ : state) {
+    int32_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+      sum += inCircle<W>(points[i], points[i + 1], points[i + 2],
+                         points[i + 3]);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_GeometryInCircle<__int128>);
+BENCHMARK(BM_GeometryInCircle<acmlib::numeric::BigInt<3>>);
+BENCHMARK(BM_GeometryInCircle<acmlib::numeric::BigInt<5>>);
+
+// Orientation predicate: sign of a cross product
+// evaluated with coordinates of type T.
+template <typename T>
+static void BM_GeometryOrientation(benchmark::State& state) {
+  const size_t n = 1 << 10;
+  std::mt19937_64 rng(0);
+  std::uniform_int_distribution<int64_t> coordinate(-(1 << 29), 1 << 29);
+  std::vector<Vector<T>> points(n + 2);
+  for (auto& P : points)
+    P = LPoint(coordinate(rng), coordinate(rng));
+  PerfCounters counters(state);
+  for (auto _ : state) {
+    int32_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+      sum += sign(Vector<T>(points[i], points[i + 1]) %
+                  Vector<T>(points[i], points[i + 2]));
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_GeometryOrientation<int64_t>);
+BENCHMARK(BM_GeometryOrientation<double>);
+BENCHMARK(BM_GeometryOrientation<Real>);
+BENCHMARK(BM_GeometryOrientation<acmlib::numeric::IntervalReal>);
+
+// Spatial sort of random points along the curve,
+// with the number of threads as the argument.
+template <Curve C>
+static void BM_GeometrySpatialSort(benchmark::State& state) {
+  const size_t n = 1 << 20;
+  std::mt19937_64 rng(0);
+  std::uniform_int_distribution<int64_t> coordinate(-(1 << 29), 1 << 29);
+  std::vector<LPoint> input(n);
+  for (auto& P : input)
+    P = {coordinate(rng), coordinate(rng)};
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<LPoint> points = input;
+    state.ResumeTiming();
+    spatialSort(points, C, state.range(0));
+    benchmark::DoNotOptimize(points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_GeometrySpatialSort<Curve::Hilbert>)->Arg(1)->Arg(4)->Arg(0);
+BENCHMARK(BM_GeometrySpatialSort<Curve::Morton>)->Arg(1)->Arg(4)->Arg(0);
+
+// Lexicographic sort of random points, with the number of threads
+// as the argument; -1 is std::sort with Vector's operator<.
+template <typename T>
+static void BM_GeometryLexicographicSort(benchmark::State& state) {
+  const size_t n = 1 << 20;
+  auto input = randomVectors<T>(n, 1);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<Point<T>> points = input;
+    state.ResumeTiming();
+    if (state.range(0) < 0)
+      std::sort(points.begin(), points.end());
+    else
+      lexicographicSort(points, state.range(0));
+    benchmark::DoNotOptimize(points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_GeometryLexicographicSort<int64_t>)->Arg(-1)->Arg(1)->Arg(4);
+BENCHMARK(BM_GeometryLexicographicSort<int32_t>)->Arg(-1)->Arg(1)->Arg(4);
+BENCHMARK(BM_GeometryLexicographicSort<double>)->Arg(-1)->Arg(1)->Arg(4);
+
+// Exact deduplication of points with many repeats,
+// argument 0 is std::sort with std::unique.
+static void BM_GeometryDeduplicate(benchmark::State& state) {
+  const size_t n = 1 << 20;
+  auto input = generatePoints<int64_t>(Distribution::UniformSquare, n, 1,
+                                       1 << 9);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<LPoint> points = input;
+    state.ResumeTiming();
+    if (state.range(0)) {
+      deduplicate(points);
+    } else {
+      std::sort(points.begin(), points.end());
+      points.erase(std::unique(points.begin(), points.end()), points.end());
+    }
+    benchmark::DoNotOptimize(points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_GeometryDeduplicate)->Arg(0)->Arg(1);
+
+// Merging of points given three times with noise below eps,
+// argument 0 is std::sort with std::unique on Real comparisons.
+static void BM_GeometryMergeNearDuplicates(benchmark::State& state) {
+  const size_t n = 1 << 18;
+  auto clean = generatePoints<double>(Distribution::UniformSquare, n / 3, 1);
+  std::mt19937_64 rng(2);
+  std::uniform_real_distribution<double> noise(-0.25e-9, 0.25e-9);
+  std::vector<RPoint> input;
+  for (int copy = 0; copy < 3; ++copy)
+    for (auto P : clean)
+      input.emplace_back(P.x() + noise(rng), P.y() + noise(rng));
+  std::shuffle(input.begin(), input.end(), rng);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<RPoint> points = input;
+    state.ResumeTiming();
+    if (state.range(0)) {
+      mergeNearDuplicates(points);
+    } else {
+      std::sort(points.begin(), points.end());
+      points.erase(std::unique(points.begin(), points.end()), points.end());
+    }
+    benchmark::DoNotOptimize(points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK(BM_GeometryMergeNearDuplicates)->Arg(0)->Arg(1);
+
+// A downstream cache-bound pass: every point splats itself
+// onto the 8 neighbouring cells of a large density grid.
+// The argument is the input order: 0 random, 1 Z-order, 2 Hilbert.
+static void BM_GeometrySpatialLocality(benchmark::State& state) {
+  const size_t n = 1 << 20;
+  const int64_t side = 1 << 12;
+  std::mt19937_64 rng(0);
+  std::uniform_int_distribution<int64_t> coordinate(1, side - 2);
+  std::vector<LPoint> points(n);
+  for (auto& P : points)
+    P = {coordinate(rng), coordinate(rng)};
+  if (state.range(0) > 0)
+    spatialSort(points, state.range(0) == 1 ? Curve::Morton : Curve::Hilbert);
+  std::vector<int32_t> grid(side * side);
+  for (auto _ : state) {
+    for (LPoint P : points)
+      for (LVector d : stencil8)
+        ++grid[(P.y() + d.y()) * side + P.x() + d.x()];
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_GeometrySpatialLocality)->Arg(0)->Arg(1)->Arg(2);
+
+// Bulk transformation of points by a matrix
+// under the execution policy E.
+template <Execution E>
+static void BM_GeometryBulkTransform(benchmark::State& state) {
+  const size_t n = 1 << 20;
+  std::mt19937_64 rng(0);
+  std::uniform_real_distribution<double> coordinate(-1e6, 1e6);
+  std::vector<Vector<double>> points(n), out(n);
+  for (auto& P : points)
+    P = {coordinate(rng), coordinate(rng)};
+  Matrix<double> m{0.6, -0.8, 0.8, 0.6};
+  for (auto _ : state) {
+    transform<E>(m, points.data(), out.data(), n);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_GeometryBulkTransform<Execution::Sequential>);
+BENCHMARK(BM_GeometryBulkTransform<Execution::Parallel>);
+BENCHMARK(BM_GeometryBulkTransform<Execution::ParallelSimd>);
+
+// Bulk sum of triangle areas under the execution policy E.
+template <Execution E>
+static void BM_GeometryBulkAreaSum(benchmark::State& state) {
+  const size_t n = 1 << 20;
+  std::mt19937_64 rng(0);
+  std::uniform_int_distribution<int64_t> coordinate(-(1 << 29), 1 << 29);
+  std::vector<LPoint> points(n + 2);
+  for (auto& P : points)
+    P = {coordinate(rng), coordinate(rng)};
+  for (auto _ : state)
+    benchmark::DoNotOptimize(triangleAreaSum<E>(
+        points.data(), points.data() + 1, points.data() + 2, n));
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_GeometryBulkAreaSum<Execution::Sequential>);
+BENCHMARK(BM_GeometryBulkAreaSum<Execution::Parallel>);
+
+// A query building short-lived point vectors, as hull and
+// clipping routines do, with scratch storage from the heap
+// (range 0) or from the thread's memory::Arena (range 1).
+static void BM_GeometryScratchVectors(benchmark::State& state) {
+  using acmlib::memory::Arena;
+  std::pmr::memory_resource* resource =
+      state.range(0) ? &Arena::local() : std::pmr::new_delete_resource();
+  for (auto _ : state) {
+    Arena::Scope scope;
+    for (int64_t k = 0; k < 16; ++k) {
+      std::pmr::vector<LPoint> points(resource);
+      for (int64_t i = 0; i < 64; ++i)
+        points.push_back({i, k * i});
+      benchmark::DoNotOptimize(points.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 16);
+}
+
+BENCHMARK(BM_GeometryScratchVectors)->Arg(0)->Arg(1);
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "benchmark/benchmark.h"
+
+// Hardware event counters of the calling thread over
+// the lifetime of the object, reported as user counters
+// of the benchmark: instructions per cycle, and cycles,
+// instructions, branch misses, L1 data cache read misses and
+// last level cache misses per item (per iteration if the
+// benchmark does not set items processed).
+//
+// Construct it right before the benchmark loop:
+//
+//   PerfCounters counters(state);
+//   for (auto _ : state) ...
+//
+// Counters come from perf_event_open and are only
+// available on Linux with perf_event_paranoid <= 2;
+// otherwise the benchmark runs without them.
+class PerfCounters {
+public:
+  explicit PerfCounters(benchmark::State& state) : state(state) {
+#ifdef __linux__
+    for (Event& event : events) {
+      perf_event_attr attr{};
+      attr.size = sizeof(attr);
+      attr.type = event.type;
+      attr.config = event.config;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format =
+          PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      event.descriptor = static_cast<int>(
+          syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+    for (Event& event : events) {
+      if (event.descriptor < 0)
+        continue;
+      ioctl(event.descriptor, PERF_EVENT_IOC_RESET, 0);
+      ioctl(event.descriptor, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  ~PerfCounters() {
+#ifdef __linux__
+    for (Event& event : events)
+      if (event.descriptor >= 0)
+        ioctl(event.descriptor, PERF_EVENT_IOC_DISABLE, 0);
+    double items = state.items_processed() > 0
+                       ? static_cast<double>(state.items_processed())
+                       : static_cast<double>(state.iterations());
+    double counts[std::size(events)];
+    for (size_t i = 0; i < std::size(events); ++i) {
+      counts[i] = -1;
+      if (events[i].descriptor < 0)
+        continue;
+      counts[i] = read(events[i].descriptor);
+      close(events[i].descriptor);
+      if (counts[i] >= 0 && items > 0)
+        state.counters[std::string(events[i].name) + "/item"] =
+            counts[i] / items;
+    }
+    // Events 0 and 1 are cycles and instructions.
+    if (counts[0] > 0 && counts[1] >= 0)
+      state.counters["IPC"] = counts[1] / counts[0];
+#endif
+  }
+
+private:
+#ifdef __linux__
+  struct Event {
+    const char* name;
+    uint32_t type;
+    uint64_t config;
+    int descriptor;
+  };
+
+  static constexpr uint64_t cacheEvent(uint64_t cache, uint64_t operation,
+                                       uint64_t result) {
+    return cache | operation << 8 | result << 16;
+  }
+
+  // The count scaled up for the time the event was
+  // multiplexed out, or -1 if it never ran.
+  static double read(int descriptor) {
+    uint64_t values[3];
+    if (::read(descriptor, values, sizeof(values)) != sizeof(values) ||
+        values[2] == 0)
+      return -1;
+    return static_cast<double>(values[0]) * values[1] / values[2];
+  }
+
+  Event events[5] = {
+      {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1},
+      {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, -1},
+      {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, -1},
+      {"L1D-misses", PERF_TYPE_HW_CACHE,
+       cacheEvent(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                  PERF_COUNT_HW_CACHE_RESULT_MISS),
+       -1},
+      {"LLC-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, -1},
+  };
+#endif
+
+  benchmark::State& state;
+};
@@ -1,5 +1,5 @@
 import os
 
-cpu_count = 16
+cpu_count = os.cpu_count()
 for cpu_id in range(cpu_count):
     os.system("sudo cpufreq-set -c {cpu_id} -g performance".format(cpu_id=cpu_id))
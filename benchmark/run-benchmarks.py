@@ -0,0 +1,207 @@
+"""Runs the benchmark suite and tracks performance regressions.
+
+    run      runs acmlib-benchmark pinned to one CPU with repetitions
+             and stores the JSON results as results/<commit>.json
+    compare  compares two stored results benchmark by benchmark
+             with the Mann-Whitney U test, and exits with status 1
+             if some benchmark got significantly slower by more
+             than the threshold
+
+Typical use:
+
+    python3 run-benchmarks.py run --binary build/acmlib-benchmark
+    python3 run-benchmarks.py compare main HEAD
+
+Only the Python standard library is needed.
+"""
+
+import argparse
+import json
+import math
+import os
+import subprocess
+import sys
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_RESULTS_DIR = os.path.join(SCRIPT_DIR, "results")
+DEFAULT_BINARY = os.path.join(SCRIPT_DIR, "build", "acmlib-benchmark")
+
+# Multipliers from google benchmark time units to nanoseconds.
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def git(*args):
+    return subprocess.run(["git", "-C", SCRIPT_DIR] + list(args),
+                          check=True, capture_output=True,
+                          text=True).stdout.strip()
+
+
+def commit_name(revision):
+    return git("rev-parse", "--short", revision)
+
+
+def work_tree_name():
+    """Short hash of HEAD, with -dirty for local changes."""
+    name = commit_name("HEAD")
+    if git("status", "--porcelain", "-uno"):
+        name += "-dirty"
+    return name
+
+
+def run(args):
+    if args.performance_governor:
+        subprocess.run([sys.executable,
+                        os.path.join(SCRIPT_DIR, "disable-cpu-scaling.py")],
+                       check=True)
+    os.makedirs(args.results_dir, exist_ok=True)
+    output = os.path.join(args.results_dir, work_tree_name() + ".json")
+    command = [
+        args.binary,
+        "--benchmark_out=" + output,
+        "--benchmark_out_format=json",
+        "--benchmark_repetitions=%d" % args.repetitions,
+        "--benchmark_enable_random_interleaving=true",
+    ]
+    if args.filter:
+        command.append("--benchmark_filter=" + args.filter)
+    if args.cpu >= 0:
+        command = ["taskset", "--cpu-list", str(args.cpu)] + command
+    subprocess.run(command + args.extra, check=True)
+    print("results stored in", output)
+
+
+def load_samples(path, metric):
+    """Per-repetition times in nanoseconds by benchmark name."""
+    with open(path) as file:
+        report = json.load(file)
+    samples = {}
+    for entry in report["benchmarks"]:
+        if entry.get("run_type", "iteration") != "iteration":
+            continue
+        if entry.get("error_occurred"):
+            continue
+        name = entry.get("run_name", entry["name"])
+        time = entry[metric] * TIME_UNITS[entry.get("time_unit", "ns")]
+        samples.setdefault(name, []).append(time)
+    return samples
+
+
+def mann_whitney(a, b):
+    """Two-sided p-value of the Mann-Whitney U test.
+
+    Uses the normal approximation with tie and continuity
+    corrections, which is adequate from about 8 samples per side.
+    """
+    n1, n2 = len(a), len(b)
+    n = n1 + n2
+    values = sorted([(x, 0) for x in a] + [(x, 1) for x in b])
+    rank_sum, ties, i = 0.0, 0.0, 0
+    while i < n:
+        j = i
+        while j < n and values[j][0] == values[i][0]:
+            j += 1
+        rank = (i + j + 1) / 2.0
+        rank_sum += rank * sum(1 for k in range(i, j) if values[k][1] == 0)
+        ties += (j - i) ** 3 - (j - i)
+        i = j
+    u = rank_sum - n1 * (n1 + 1) / 2.0
+    mean = n1 * n2 / 2.0
+    variance = n1 * n2 / 12.0 * ((n + 1) - ties / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+    z = max(abs(u - mean) - 0.5, 0.0) / math.sqrt(variance)
+    return math.erfc(z / math.sqrt(2))
+
+
+def median(values):
+    values = sorted(values)
+    middle = len(values) // 2
+    if len(values) % 2:
+        return values[middle]
+    return (values[middle - 1] + values[middle]) / 2.0
+
+
+def resolve(result, results_dir):
+    """A results file given by path, commit name or git revision."""
+    if os.path.isfile(result):
+        return result
+    path = os.path.join(results_dir, result + ".json")
+    if os.path.isfile(path):
+        return path
+    try:
+        path = os.path.join(results_dir, commit_name(result) + ".json")
+    except subprocess.CalledProcessError:
+        sys.exit("no results for " + result)
+    if not os.path.isfile(path):
+        sys.exit("no results for " + result)
+    return path
+
+
+def compare(args):
+    baseline = load_samples(resolve(args.baseline, args.results_dir),
+                            args.metric)
+    candidate = load_samples(resolve(args.candidate, args.results_dir),
+                             args.metric)
+    regressions = 0
+    print("%-60s %12s %12s %8s %8s" %
+          ("benchmark", "baseline", "candidate", "change", "p"))
+    for name in sorted(set(baseline) & set(candidate)):
+        old, new = baseline[name], candidate[name]
+        change = median(new) / median(old) - 1
+        p = mann_whitney(old, new)
+        verdict = ""
+        if p < args.alpha and abs(change) > args.threshold:
+            verdict = "REGRESSION" if change > 0 else "improvement"
+            regressions += change > 0
+        print("%-60s %10.1fns %10.1fns %+7.1f%% %8.4f %s" %
+              (name[:60], median(old), median(new), 100 * change, p,
+               verdict))
+    for name in sorted(set(baseline) ^ set(candidate)):
+        print("%-60s only in %s" %
+              (name[:60], "baseline" if name in baseline else "candidate"))
+    if regressions:
+        print("%d significant regression(s) above %.1f%%" %
+              (regressions, 100 * args.threshold))
+        sys.exit(1)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    common = argparse.ArgumentParser(add_help=False)
+    common.add_argument("--results-dir", default=DEFAULT_RESULTS_DIR)
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    run_parser = commands.add_parser("run", parents=[common],
+                                     help="run and store results")
+    run_parser.add_argument("--binary", default=DEFAULT_BINARY)
+    run_parser.add_argument("--cpu", type=int, default=1,
+                            help="CPU to pin to, -1 to not pin")
+    run_parser.add_argument("--repetitions", type=int, default=10)
+    run_parser.add_argument("--filter", help="benchmark name regex")
+    run_parser.add_argument("--performance-governor", action="store_true",
+                            help="set the performance governor first")
+    run_parser.add_argument("extra", nargs="*",
+                            help="more arguments for the binary, after --")
+    run_parser.set_defaults(handler=run)
+
+    compare_parser = commands.add_parser(
+        "compare", parents=[common],
+        help="compare results and fail on regressions")
+    compare_parser.add_argument("baseline")
+    compare_parser.add_argument("candidate")
+    compare_parser.add_argument("--metric", default="cpu_time",
+                                choices=["cpu_time", "real_time"])
+    compare_parser.add_argument("--threshold", type=float, default=0.05,
+                                help="relative slowdown to fail on")
+    compare_parser.add_argument("--alpha", type=float, default=0.01,
+                                help="significance level")
+    compare_parser.set_defaults(handler=compare)
+
+    args = parser.parse_args()
+    args.handler(args)
+
+
+if __name__ == "__main__":
+    main()
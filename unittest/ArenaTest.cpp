@@ -0,0 +1,94 @@
+#include <cstdint>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+#include "Arena.hpp"
+#include "Geometry.hpp"
+#include "Parallel.hpp"
+#include "RadixSort.hpp"
+#include "doctest.h"
+
+using namespace acmlib::geometry;
+using namespace acmlib::memory;
+
+TEST_SUITE("Memory::Arena") {
+  TEST_CASE("Allocations are aligned and disjoint") {
+    Arena arena(256);
+    std::vector<char *> starts;
+    for (size_t alignment : {1, 2, 8, 16, 64, 4096, 8}) {
+      char *p = static_cast<char *>(arena.allocate(100, alignment));
+      CHECK(reinterpret_cast<uintptr_t>(p) % alignment == 0);
+      for (char *q : starts)
+        CHECK((p + 100 <= q || q + 100 <= p));
+      starts.push_back(p);
+    }
+    CHECK(arena.allocate(1 << 20, 8) != nullptr);
+    CHECK(arena.capacity() >= (1 << 20));
+  }
+
+  TEST_CASE("Scopes rewind in stack order") {
+    Arena arena(1024);
+    void *outer = arena.allocate(16, 8);
+    void *inside;
+    {
+      Arena::Scope scope(arena);
+      inside = arena.allocate(16, 8);
+      {
+        Arena::Scope nested(arena);
+        CHECK(arena.allocate(16, 8) != nullptr);
+      }
+      CHECK(arena.allocate(16, 8) == static_cast<char *>(inside) + 16);
+    }
+    CHECK(arena.allocate(16, 8) == inside);
+    CHECK(outer != inside);
+  }
+
+  TEST_CASE("Blocks merge once the arena is empty") {
+    Arena arena(64);
+    for (int i = 0; i < 10; ++i)
+      CHECK(arena.allocate(100, 8) != nullptr);
+    size_t allocations = arena.upstreamAllocations();
+    CHECK(allocations > 1);
+    arena.reset();
+    CHECK(arena.upstreamAllocations() == allocations + 1);
+    for (int round = 0; round < 5; ++round) {
+      Arena::Scope scope(arena);
+      for (int i = 0; i < 10; ++i)
+        CHECK(arena.allocate(100, 8) != nullptr);
+    }
+    CHECK(arena.upstreamAllocations() == allocations + 1);
+  }
+
+  TEST_CASE("Polymorphic containers") {
+    Arena arena;
+    Arena::Scope scope(arena);
+    std::pmr::vector<LPoint> points(&arena);
+    for (int64_t i = 0; i < 1000; ++i)
+      points.push_back({i, -i});
+    CHECK(points.size() == 1000);
+    CHECK(points[999] == LPoint(999, -999));
+    std::pmr::vector<LPoint> copy(points, &arena);
+    CHECK(copy == points);
+    CHECK(*points.get_allocator().resource() == arena);
+  }
+
+  TEST_CASE("Algorithms stop allocating after warmup") {
+    std::mt19937_64 rng(40);
+    std::vector<uint64_t> values(100000);
+    auto sortAll = [&] {
+      for (uint64_t &value : values)
+        value = rng();
+      acmlib::algorithm::radixSortByKey(values, [](uint64_t v) { return v; });
+      acmlib::parallel::parallelReduce(
+          0, values.size(), uint64_t(0),
+          [&](size_t begin, size_t end) { return values[end - 1] - begin; },
+          [](uint64_t a, uint64_t b) { return a ^ b; }, 64);
+    };
+    sortAll();
+    size_t allocations = Arena::local().upstreamAllocations();
+    for (int round = 0; round < 5; ++round)
+      sortAll();
+    CHECK(Arena::local().upstreamAllocations() == allocations);
+  }
+}
@@ -0,0 +1,139 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "Geometry.hpp"
+#include "Rational.hpp"
+#include "doctest.h"
+
+using doctest::Approx;
+using namespace acmlib::geometry;
+using namespace acmlib::numeric;
+
+TEST_SUITE("Numeric::BigInt") {
+  using Int128 = BigInt<2>;
+  using Int256 = BigInt<4>;
+
+  TEST_CASE("Agrees with __int128") {
+    std::mt19937_64 rng(123);
+    for (int iteration = 0; iteration < 10000; ++iteration) {
+      __int128 a = static_cast<int64_t>(rng()), b = static_cast<int64_t>(rng());
+      a *= static_cast<int32_t>(rng());
+      b >>= rng() % 40;
+      CHECK((__int128)(Int128(a) + Int128(b)) == a + b);
+      CHECK((__int128)(Int128(a) - Int128(b)) == a - b);
+      CHECK((__int128)(Int128(a) * Int128(b >> 32)) == a * (b >> 32));
+      if (b != 0) {
+        CHECK((__int128)(Int128(a) / Int128(b)) == a / b);
+        CHECK((__int128)(Int128(a) % Int128(b)) == a % b);
+      }
+      CHECK((Int128(a) < Int128(b)) == (a < b));
+      CHECK((Int128(a) == Int128(b)) == (a == b));
+      CHECK(Int128(a).sign() == (a > 0) - (a < 0));
+    }
+  }
+
+  TEST_CASE("Wide products") {
+    Int256 x = std::numeric_limits<int64_t>::min();
+    Int256 y = x * x * x * x;
+    std::ostringstream os;
+    os << y << ' ' << -y;
+    CHECK(os.str() == "7237005577332262213973186563042994240829374041602535252"
+                      "466099000494570602496 -72370055773322622139731865630429"
+                      "94240829374041602535252466099000494570602496");
+    CHECK(y / x / x / x == x);
+    CHECK(y % (x * x * x + 1) != 0);
+    CHECK(Int256(BigInt<5>(y)) == y);
+    CHECK(BigInt<5>(-y).sign() == -1);
+    CHECK((long double)(-y) == Approx(-std::pow(2.0l, 252)));
+  }
+
+  TEST_CASE("Overflow detection agrees with __int128") {
+    std::mt19937_64 rng(7);
+    for (int iteration = 0; iteration < 10000; ++iteration) {
+      __int128 a = static_cast<__int128>(rng()) << 64 | rng();
+      __int128 b = static_cast<__int128>(rng()) << 64 | rng();
+      a >>= rng() % 128;
+      b >>= rng() % 128;
+      __int128 expected;
+      Int128 result;
+      CHECK(Int128::addOverflow(a, b, result) ==
+            __builtin_add_overflow(a, b, &expected));
+      CHECK((__int128)result == expected);
+      CHECK(Int128::mulOverflow(a, b, result) ==
+            __builtin_mul_overflow(a, b, &expected));
+      CHECK((__int128)result == expected);
+    }
+    const __int128 min = static_cast<__int128>(1) << 127;
+    Int128 result;
+    CHECK(!Int128::mulOverflow(Int128(min / 2), Int128(2), result));
+    CHECK((__int128)result == min);
+    CHECK(Int128::mulOverflow(Int128(min / 2), Int128(-2), result));
+    CHECK(Int128::mulOverflow(Int128(min), Int128(-1), result));
+    CHECK(Int128::addOverflow(Int128(min), Int128(-1), result));
+  }
+
+  TEST_CASE("I/O stream operators") {
+    std::istringstream is("-123456789012345678901234567890 0 42");
+    std::vector<std::string> expected{"-123456789012345678901234567890", "0",
+                                      "42"};
+    for (const auto &value : expected) {
+      Int256 x;
+      is >> x;
+      std::ostringstream os;
+      os << x;
+      CHECK(os.str() == value);
+    }
+  }
+
+  TEST_CASE("As Vector coordinates") {
+    Vector<Int256> a{int64_t(1) << 62, 3}, b{-(int64_t(1) << 62), 5};
+    Int256 cross = a % b;
+    CHECK(cross == Int256(int64_t(1) << 62) * 8);
+    CHECK((a ^ b) == -(Int256(int64_t(1) << 62) * (int64_t(1) << 62)) + 15);
+    CHECK(sign(a % b) == 1);
+    CHECK(Vector<Int256>(a, b) ==
+          Vector<Int256>(Int256(int64_t(1) << 62) * -2, 2));
+  }
+
+  TEST_CASE("As Rational integers") {
+    using BigRational = Rational<Int256>;
+    BigRational third(1, 3);
+    BigRational sum;
+    for (int i = 0; i < 3; ++i)
+      sum += third;
+    CHECK(sum == 1);
+    CHECK(BigRational(Int256(6), Int256(-4)).numerator() == -3);
+
+    // Exact or throws, as with built-in integers.
+    Int256 big = std::numeric_limits<int64_t>::max();
+    BigRational huge = BigRational(big * big * big);
+    CHECK_THROWS_AS(huge * huge, std::overflow_error);
+    BigRational top = BigRational(big * big * big * big * 7);
+    CHECK_THROWS_AS(top + top, std::overflow_error);
+    CHECK(huge / huge == 1);
+  }
+
+  TEST_CASE("inCircle") {
+    LPoint A{0, 0}, B{4, 0}, C{0, 4};
+    CHECK(inCircle<__int128>(A, B, C, LPoint(1, 1)) == 1);
+    CHECK(inCircle<__int128>(A, B, C, LPoint(4, 4)) == 0);
+    CHECK(inCircle<__int128>(A, B, C, LPoint(5, 5)) == -1);
+    CHECK(inCircle<__int128>(A, C, B, LPoint(1, 1)) == -1);
+
+    // Coordinates near the int64_t limits need 320 bits.
+    const int64_t M = std::numeric_limits<int64_t>::max();
+    LPoint P{-M, -M}, Q{M, -M}, R{M, M};
+    CHECK(inCircle<BigInt<5>>(P, Q, R, LPoint(-M, M)) == 0);
+    CHECK(inCircle<BigInt<5>>(P, Q, R, LPoint(-M + 1, M)) == 1);
+    CHECK(inCircle<BigInt<5>>(P, Q, R, LPoint(0, 0)) == 1);
+    CHECK(inCircle<BigInt<5>>(R, Q, P, LPoint(0, 0)) == -1);
+    CHECK(inCircle<Real>(RPoint(0, 0), RPoint(4, 0), RPoint(0, 4),
+                         RPoint(1, 1)) == 1);
+  }
+}
@@ -0,0 +1,259 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FastIO.hpp"
+#include "Geometry.hpp"
+#include "doctest.h"
+
+using namespace acmlib::geometry;
+using namespace acmlib::io;
+
+TEST_SUITE("IO::Reader") {
+  TEST_CASE("Integers") {
+    std::string input = " 42\n-17 +5\t0 9223372036854775807 "
+                        "-9223372036854775808 18446744073709551615 "
+                        "-170141183460469231731687303715884105728 x";
+    Reader in(input.data(), input.size());
+    int32_t a, b, c, d;
+    int64_t max, min;
+    uint64_t umax;
+    __int128 wide;
+    CHECK(bool(in >> a >> b >> c >> d >> max >> min >> umax >> wide));
+    CHECK(a == 42);
+    CHECK(b == -17);
+    CHECK(c == 5);
+    CHECK(d == 0);
+    CHECK(max == std::numeric_limits<int64_t>::max());
+    CHECK(min == std::numeric_limits<int64_t>::min());
+    CHECK(umax == std::numeric_limits<uint64_t>::max());
+    CHECK(wide == -(__int128(1) << 126) * 2);
+    CHECK(!(in >> a));
+    CHECK(a == 42);
+
+    // Out of range, or a sign apart from its number.
+    for (std::string bad :
+         {"2147483648", "-2147483649", "99999999999999999999", "- 5",
+          "+ 5", "-"}) {
+      Reader numbers(bad.data(), bad.size());
+      int32_t value = 7;
+      CHECK(!(numbers >> value));
+      CHECK(value == 7);
+    }
+    std::string edges = "2147483647 -2147483648 255 -128 "
+                        "170141183460469231731687303715884105728";
+    Reader bounds(edges.data(), edges.size());
+    uint8_t byte;
+    int8_t small;
+    CHECK(bool(bounds >> a >> b >> byte >> small));
+    CHECK(a == std::numeric_limits<int32_t>::max());
+    CHECK(b == std::numeric_limits<int32_t>::min());
+    CHECK(byte == 255);
+    CHECK(small == -128);
+    CHECK(!(bounds >> wide));
+  }
+
+  TEST_CASE("Floating point") {
+    std::string input = "3.25 -0.5 1e3 2.5E-3 .75 -12. 0.000000000000000000123 "
+                        "123456789012345678901234 inf -nan 7";
+    Reader in(input.data(), input.size());
+    double x[10];
+    CHECK(bool(in.read(x, 10)));
+    CHECK(x[0] == 3.25);
+    CHECK(x[1] == -0.5);
+    CHECK(x[2] == 1000);
+    CHECK(x[3] == 2.5e-3);
+    CHECK(x[4] == 0.75);
+    CHECK(x[5] == -12);
+    CHECK(x[6] == 1.23e-19);
+    CHECK(x[7] == 123456789012345678901234.0);
+    CHECK(x[8] == std::numeric_limits<double>::infinity());
+    CHECK(std::isnan(x[9]));
+    long double y;
+    CHECK(bool(in >> y));
+    CHECK(y == 7);
+    CHECK(!(in >> y));
+    for (std::string bad : {"- 5", "- inf", "-"}) {
+      Reader signs(bad.data(), bad.size());
+      CHECK(!(signs >> y));
+      CHECK(y == 7);
+    }
+
+    // Round trip of random doubles printed with 17 digits.
+    std::mt19937_64 rng(36);
+    std::ostringstream os;
+    os.precision(17);
+    std::vector<double> expected(1000), actual(1000);
+    for (double &value : expected) {
+      value = std::ldexp(double(rng() >> 11), int(rng() % 80) - 90);
+      os << value << ' ';
+    }
+    std::string printed = os.str();
+    Reader numbers(printed.data(), printed.size());
+    CHECK(bool(numbers.read(actual)));
+    CHECK(actual == expected);
+  }
+
+  TEST_CASE("Words and characters") {
+    std::string input = "  hello  w\n;";
+    Reader in(input.data(), input.size());
+    std::string word;
+    char c, d;
+    CHECK(bool(in >> word >> c >> d));
+    CHECK(word == "hello");
+    CHECK(c == 'w');
+    CHECK(d == ';');
+    CHECK(in.peek() == EOF);
+  }
+
+  TEST_CASE("Geometry") {
+    std::string input = "1 -2  0.5 2.5  1 2 3  1 2 3 4";
+    Reader in(input.data(), input.size());
+    LVector v;
+    RVector r;
+    LLine l;
+    Matrix<int64_t> m;
+    CHECK(bool(in >> v >> r >> l >> m));
+    CHECK(v == LVector(1, -2));
+    CHECK(r == RVector(0.5, 2.5));
+    CHECK(l.a() == 1);
+    CHECK(l.b() == 2);
+    CHECK(l.c() == 3);
+    CHECK(m == Matrix<int64_t>(1, 2, 3, 4));
+  }
+
+  TEST_CASE("Files") {
+    std::ostringstream os;
+    std::vector<LPoint> expected(50000);
+    for (size_t i = 0; i < expected.size(); ++i) {
+      expected[i] = {int64_t(i) * 7919 - 100000, -int64_t(i)};
+      os << expected[i] << '\n';
+    }
+    std::string text = os.str();
+
+    // A regular file is memory-mapped.
+    std::FILE *file = std::tmpfile();
+    REQUIRE(file);
+    std::fputs("skipped\n", file);
+    std::fputs(text.c_str(), file);
+    std::fflush(file);
+    std::fseek(file, 8, SEEK_SET);
+    {
+      Reader in(file);
+      std::vector<LPoint> points(expected.size());
+      CHECK(bool(in.read(points)));
+      CHECK(points == expected);
+    }
+    std::fclose(file);
+
+    // A memory stream has no descriptor and goes
+    // through the buffer, refilled many times.
+    std::FILE *stream = fmemopen(&text[0], text.size(), "r");
+    REQUIRE(stream);
+    {
+      Reader in(stream);
+      std::vector<LPoint> points(expected.size());
+      CHECK(bool(in.read(points)));
+      CHECK(points == expected);
+      LPoint extra;
+      CHECK(!(in >> extra));
+    }
+    std::fclose(stream);
+  }
+}
+
+TEST_SUITE("IO::Writer") {
+  // Everything written by write(out) to a temporary file.
+  template <typename F>
+  std::string written(F write) {
+    std::FILE *file = std::tmpfile();
+    REQUIRE(file);
+    {
+      Writer out(file);
+      write(out);
+    }
+    std::string result(std::ftell(file), '\0');
+    std::rewind(file);
+    CHECK(std::fread(&result[0], 1, result.size(), file) == result.size());
+    std::fclose(file);
+    return result;
+  }
+
+  TEST_CASE("Integers") {
+    CHECK(written([](Writer &out) {
+            out << 0 << ' ' << 7 << ' ' << -42 << ' ' << 100 << ' '
+                << int64_t(-9223372036854775807 - 1) << ' '
+                << uint64_t(18446744073709551615ull) << ' '
+                << -(__int128(1) << 100);
+          }) == "0 7 -42 100 -9223372036854775808 18446744073709551615 "
+                "-1267650600228229401496703205376");
+    CHECK(written([](Writer &out) { out << true << ' ' << false; }) ==
+          "1 0");
+    std::mt19937_64 rng(37);
+    for (int i = 0; i < 1000; ++i) {
+      int64_t x = int64_t(rng()) >> (rng() % 64);
+      CHECK(written([x](Writer &out) { out << x; }) == std::to_string(x));
+    }
+  }
+
+  TEST_CASE("Floating point") {
+    CHECK(written([](Writer &out) {
+            out << 0.1 << ' ' << -2.5 << ' ' << 1e300 << ' ' << 0.0;
+          }) == "0.1 -2.5 1e+300 0");
+    CHECK(written([](Writer &out) {
+            out.setPrecision(3);
+            out << 3.14159 << ' ' << -0.0005 << ' ' << Real(2);
+            out.setPrecision(-1);
+            out << ' ' << 0.125f;
+          }) == "3.142 -0.001 2.000 0.125");
+
+    // Huge fixed-notation output does not fit the buffer at once.
+    std::string huge = written([](Writer &out) {
+      out.setPrecision(2);
+      for (int i = 0; i < 300; ++i)
+        out << 1e300 << '\n';
+    });
+    CHECK(huge.size() == 300 * 305);
+    CHECK(huge.substr(0, 4) == "1000");
+  }
+
+  TEST_CASE("Text and geometry") {
+    CHECK(written([](Writer &out) {
+            out << "abc" << std::string(" de") << '\n'
+                << LVector(1, -2) << ';' << LLine(LPoint(0, 0), LPoint(1, 1))
+                << ';' << Matrix<int64_t>(1, 2, 3, 4) << ';'
+                << std::vector<int32_t>{5, 6};
+          }) == "abc de\n1 -2;1 -1 0;1 2 3 4;5 6 ");
+    std::vector<LPoint> points{{1, 2}, {3, 4}};
+    CHECK(written([&](Writer &out) {
+            out.write(points.data(), points.size(), '\n');
+          }) == "1 2\n3 4");
+
+    // Output longer than the buffer.
+    std::string text = written([](Writer &out) {
+      for (int i = 0; i < 100000; ++i)
+        out << i % 10;
+      out << std::string(200000, 'x');
+    });
+    CHECK(text.size() == 300000);
+    CHECK(text.substr(99990, 12) == "0123456789xx");
+  }
+
+  TEST_CASE("Round trip with Reader") {
+    std::mt19937_64 rng(37);
+    std::vector<double> values(1000), back(1000);
+    for (double &value : values)
+      value = std::ldexp(double(rng() >> 11), int(rng() % 200) - 100);
+    std::string text = written([&](Writer &out) {
+      out.write(values.data(), values.size());
+    });
+    Reader in(text.data(), text.size());
+    CHECK(bool(in.read(back)));
+    CHECK(back == values);
+  }
+}
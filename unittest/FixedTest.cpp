@@ -0,0 +1,143 @@
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "Fixed.hpp"
+#include "Geometry.hpp"
+#include "doctest.h"
+
+using doctest::Approx;
+using namespace acmlib::geometry;
+using namespace acmlib::numeric;
+
+TEST_SUITE("Numeric::Fixed") {
+  TEST_CASE("Storage") {
+    CHECK(sizeof(Fixed32) == 4);
+    CHECK(sizeof(Fixed64) == 8);
+    CHECK(sizeof(Vector<Fixed32>) == 8);
+    CHECK(Fixed32(1).raw() == 1 << 16);
+    CHECK(Fixed32(-0.5).raw() == -(1 << 15));
+    CHECK(Fixed64(3).raw() == int64_t(3) << 32);
+    CHECK(Fixed32::fromRaw(1).raw() == 1);
+  }
+
+  TEST_CASE("Conversions") {
+    CHECK((double)Fixed32(1.25) == 1.25);
+    CHECK((int)Fixed32(-7.75) == -7);
+    CHECK((int)Fixed32(7.75) == 7);
+    CHECK((double)Fixed64(1e-9) == Approx(1e-9).epsilon(1e-2));
+    CHECK(Fixed32(Fixed64(2.5)) == Fixed32(2.5));
+    CHECK(Fixed64(Fixed32(-2.5)) == Fixed64(-2.5));
+  }
+
+  TEST_CASE("Arithmetic") {
+    CHECK(Fixed32(1.5) + Fixed32(2.25) == Fixed32(3.75));
+    CHECK(Fixed32(1.5) - 4 == Fixed32(-2.5));
+    CHECK(Fixed32(1.5) * Fixed32(-2.5) == Fixed32(-3.75));
+    CHECK(Fixed32(7) / Fixed32(2) == Fixed32(3.5));
+    CHECK(Fixed32(-7) / Fixed32(2) == Fixed32(-3.5));
+    CHECK(Fixed32(1) / 3 == Fixed32::fromRaw(21845));
+    CHECK(Fixed32(2) / 3 == Fixed32::fromRaw(43691));
+    CHECK(Fixed32(-2) / 3 == Fixed32::fromRaw(-43691));
+    CHECK(Fixed64(1e6) * Fixed64(1e3) == Fixed64(1e9));
+    Fixed32 x = 0.5;
+    CHECK(++x == 1.5);
+    CHECK(x-- == 1.5);
+    CHECK(x == 0.5);
+    CHECK(-x == -0.5);
+    CHECK(fabs(Fixed32(-3)) == 3);
+    CHECK(floor(Fixed32(-2.5)) == -3);
+    CHECK(ceil(Fixed32(-2.5)) == -2);
+    CHECK(floor(Fixed32(2.5)) == 2);
+
+    // Wrap-around, without signed overflow.
+    const int32_t max32 = std::numeric_limits<int32_t>::max();
+    const int32_t min32 = std::numeric_limits<int32_t>::min();
+    const int64_t min64 = std::numeric_limits<int64_t>::min();
+    CHECK((Fixed32::fromRaw(max32) + Fixed32::fromRaw(1)).raw() == min32);
+    CHECK((Fixed32::fromRaw(min32) - Fixed32::fromRaw(1)).raw() == max32);
+    CHECK((-Fixed32::fromRaw(min32)).raw() == min32);
+    Fixed32 top = Fixed32::fromRaw(max32);
+    CHECK((++top).raw() == min32 + Fixed32::one - 1);
+    CHECK((-Fixed64::fromRaw(min64)).raw() == min64);
+  }
+
+  TEST_CASE("Comparison is exact") {
+    CHECK(Fixed32(1) < Fixed32::fromRaw((1 << 16) + 1));
+    CHECK(Fixed32(1) != Fixed32::fromRaw((1 << 16) + 1));
+    CHECK(Fixed32(2) >= 2);
+    CHECK(sign(Fixed32::fromRaw(-1)) == -1);
+  }
+
+  TEST_CASE("sqrt") {
+    CHECK(sqrt(Fixed32(4)) == 2);
+    CHECK(sqrt(Fixed32(0)) == 0);
+    CHECK(sqrt(Fixed32(-1)) == 0);
+    CHECK((double)sqrt(Fixed32(2)) == Approx(std::sqrt(2.0)).epsilon(1e-4));
+    CHECK((double)sqrt(Fixed64(2)) ==
+          Approx(std::sqrt(2.0)).epsilon(1e-9));
+    CHECK(sqrt(Fixed64(1e9)).raw() == 135818791312945);
+  }
+
+  TEST_CASE("Trigonometry accuracy") {
+    double maxError32 = 0, maxError64 = 0;
+    for (int i = -1000; i <= 1000; ++i) {
+      double angle = i * 0.0271;
+      Fixed64 s64, c64;
+      sincos(Fixed64(angle), s64, c64);
+      double exactAngle = (double)Fixed64(angle);
+      maxError64 = std::max(maxError64,
+                            std::fabs((double)s64 - std::sin(exactAngle)));
+      maxError64 = std::max(maxError64,
+                            std::fabs((double)c64 - std::cos(exactAngle)));
+      double y = std::sin(i * 0.3) * 100, x = std::cos(i * 0.7) * 50;
+      Fixed32 fy = y, fx = x;
+      double exact = std::atan2((double)fy, (double)fx);
+      maxError32 =
+          std::max(maxError32, std::fabs((double)atan2(fy, fx) - exact));
+      maxError64 = std::max(maxError64,
+                            std::fabs((double)atan2(Fixed64(y), Fixed64(x)) -
+                                      std::atan2((double)Fixed64(y),
+                                                 (double)Fixed64(x))));
+    }
+    CHECK(maxError32 < 1e-4);
+    CHECK(maxError64 < 1e-9);
+    CHECK(atan2(Fixed32(0), Fixed32(-1)) == Fixed32::fromRaw(205887));
+    CHECK(atan2(Fixed32(0), Fixed32(0)) == 0);
+    CHECK((double)atan2(Fixed32(-1), Fixed32(0)) ==
+          Approx(-std::acos(0.0)).epsilon(1e-4));
+    CHECK((double)cos(Fixed32(100)) == Approx(std::cos(100.0)).epsilon(1e-3));
+
+    // The minimum, whose negation does not fit.
+    Fixed64 min = Fixed64::fromRaw(std::numeric_limits<int64_t>::min());
+    CHECK((double)atan2(min, min) == Approx(-3 * std::acos(0.0) / 2));
+    CHECK((double)atan2(Fixed64(1), min) == Approx(2 * std::acos(0.0)));
+    CHECK((double)atan2(min, Fixed64(0)) == Approx(-std::acos(0.0)));
+  }
+
+  TEST_CASE("Deterministic results") {
+    // Golden raw values: any platform must reproduce them bit for bit.
+    CHECK(sqrt(Fixed64(2)).raw() == 6074000999);
+    CHECK(atan2(Fixed64(1), Fixed64(3)).raw() == 1381908109);
+    CHECK(sin(Fixed64(1)).raw() == 3614090360);
+    CHECK(cos(Fixed64(1)).raw() == 2320580734);
+    CHECK((Fixed64(1) / 7).raw() == 613566757);
+  }
+
+  TEST_CASE("Geometry with fixed-point coordinates") {
+    using FVector = Vector<Fixed32>;
+    FVector a{1.5, 2}, b{-0.5, 4};
+    CHECK(a + b == FVector(1, 6));
+    CHECK(a % b == 7);
+    CHECK((a ^ b) == 7.25);
+    CHECK(FVector(3, 4).len() == 5);
+    CHECK(triangleArea(a, b) == 3.5);
+    Line<Fixed32> l{FVector(0, 0), FVector(2, 1)};
+    CHECK(l.relativePosition({1, 1}) == -1);
+    CHECK(l.contains({1, 0.5}));
+    std::ostringstream os;
+    os << a;
+    CHECK(os.str() == "1.5 2");
+  }
+}
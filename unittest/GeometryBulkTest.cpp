@@ -0,0 +1,79 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Geometry.hpp"
+#include "GeometryBulk.hpp"
+#include "doctest.h"
+
+using namespace acmlib::geometry;
+
+TEST_SUITE("Geometry::Bulk") {
+  template <Execution E>
+  void checkPolicy() {
+    std::mt19937_64 rng(34);
+    std::uniform_int_distribution<int64_t> coordinate(-1000000, 1000000);
+    const size_t n = 20000;
+    std::vector<LPoint> points(n), A(n), B(n), C(n);
+    for (auto *array : {&points, &A, &B, &C})
+      for (LPoint &P : *array)
+        P = {coordinate(rng), coordinate(rng)};
+
+    Matrix<int64_t> m{2, -1, 3, 5};
+    std::vector<LPoint> transformed(n);
+    transform<E>(m, points.data(), transformed.data(), n);
+    std::vector<int64_t> distances(n);
+    LPoint query{17, -4};
+    dist2<E>(query, points.data(), distances.data(), n);
+    LLine l{LPoint(-5, 3), LPoint(8, 1)};
+    std::vector<int32_t> sides(n);
+    classify<E>(l, points.data(), sides.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      CHECK(transformed[i] == m * points[i]);
+      CHECK(distances[i] == dist2(query, points[i]));
+      CHECK(sides[i] == l.relativePosition(points[i]));
+    }
+
+    LPoint lo, hi;
+    boundingBox<E>(points.data(), n, lo, hi);
+    LPoint expectedLo = points[0], expectedHi = points[0];
+    for (LPoint P : points) {
+      expectedLo = {std::min(expectedLo.x(), P.x()),
+                    std::min(expectedLo.y(), P.y())};
+      expectedHi = {std::max(expectedHi.x(), P.x()),
+                    std::max(expectedHi.y(), P.y())};
+    }
+    CHECK(lo == expectedLo);
+    CHECK(hi == expectedHi);
+
+    // Block sums are combined in a fixed order,
+    // so the result is the same under every policy.
+    Real area = triangleAreaSum<E>(A.data(), B.data(), C.data(), n);
+    Real expected = triangleAreaSum<Execution::Sequential>(
+        A.data(), B.data(), C.data(), n);
+    CHECK((long double)area == (long double)expected);
+    long double naive = 0;
+    for (size_t i = 0; i < n; ++i)
+      naive += (long double)triangleArea(A[i], B[i], C[i]);
+    CHECK(area == naive);
+
+    // In-place transformation.
+    std::vector<LPoint> copy = points;
+    transform<Execution::Parallel>(m, copy.data(), copy.data(), n);
+    CHECK(copy == transformed);
+  }
+
+  TEST_CASE("Policies") {
+    checkPolicy<Execution::Sequential>();
+    checkPolicy<Execution::Parallel>();
+    checkPolicy<Execution::ParallelSimd>();
+  }
+
+  TEST_CASE("Single point") {
+    RPoint P{1.5, -2};
+    RPoint lo, hi;
+    boundingBox<Execution::Parallel>(&P, 1, lo, hi);
+    CHECK(lo == P);
+    CHECK(hi == P);
+  }
+}
@@ -1,4 +1,5 @@
 #include <array>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <sstream>
@@ -244,6 +245,93 @@ TEST_SUITE("Geometry::Real") {
     CHECK(cos(Real(4 * std::atan(1))) == -1);
   }
 
+  TEST_CASE("Accuracy tiers of elementary functions") {
+    const long double pi = std::acos(-1.0l);
+    long double maxSinError[3] = {}, maxAtan2Error[3] = {};
+    auto update = [](long double &maxError, Real found, long double expected) {
+      maxError = std::max(maxError, std::fabs((long double)found - expected));
+    };
+    for (int i = -20000; i <= 20000; ++i) {
+      long double x = i * 0.01237l;
+      long double expectedSin = std::sin(x), expectedCos = std::cos(x);
+      Real s, c;
+      sincos<Accuracy::Libm>(x, s, c);
+      update(maxSinError[0], s, expectedSin);
+      update(maxSinError[0], c, expectedCos);
+      sincos<Accuracy::Nano>(x, s, c);
+      update(maxSinError[1], s, expectedSin);
+      update(maxSinError[1], c, expectedCos);
+      update(maxSinError[2], sin<Accuracy::Micro>(x), expectedSin);
+      update(maxSinError[2], cos<Accuracy::Micro>(x), expectedCos);
+
+      long double y = std::sin(i * 0.7l) * (i % 7);
+      long double expectedAtan2 = std::atan2(y, x);
+      update(maxAtan2Error[0], atan2<Accuracy::Libm>(y, x), expectedAtan2);
+      update(maxAtan2Error[1], atan2<Accuracy::Nano>(y, x), expectedAtan2);
+      update(maxAtan2Error[2], atan2<Accuracy::Micro>(y, x), expectedAtan2);
+    }
+    CHECK(maxSinError[0] == 0);
+    CHECK(maxSinError[1] < 1e-9);
+    CHECK(maxSinError[2] < 1e-6);
+    CHECK(maxAtan2Error[0] == 0);
+    CHECK(maxAtan2Error[1] < 1e-9);
+    CHECK(maxAtan2Error[2] < 1e-6);
+    CHECK(sin<Accuracy::Nano>(Real(1e6)) == std::sin(1e6l));
+
+    CHECK(atan2<Accuracy::Nano>(0, 0) == 0);
+    CHECK(atan2<Accuracy::Nano>(1, 0) == pi / 2);
+    CHECK(atan2<Accuracy::Nano>(0, -1) == pi);
+    CHECK(atan2<Accuracy::Micro>(-1, -1) == -3 * pi / 4);
+
+    CHECK(sqrt<Accuracy::Libm>(Real(2)) == std::sqrt(2.0l));
+    CHECK(sqrt<Accuracy::Nano>(Real(1e10 + 1)) == std::sqrt(1e10l + 1));
+    CHECK(std::fabs((long double)sqrt<Accuracy::Micro>(Real(3)) -
+                    std::sqrt(3.0l)) < 1e-6);
+    // Outside the range of float, and of double.
+    for (long double v : {1e60l, 1e-60l, 1e400l, 1e-400l}) {
+      long double micro = (long double)sqrt<Accuracy::Micro>(Real(v));
+      long double nano = (long double)sqrt<Accuracy::Nano>(Real(v));
+      CHECK(std::fabs(micro / std::sqrt(v) - 1) < 1e-15);
+      CHECK(std::fabs(nano / std::sqrt(v) - 1) < 1e-15);
+    }
+    CHECK(sqrt<Accuracy::Micro>(Real(0)) == 0);
+    CHECK(std::isnan((long double)sqrt<Accuracy::Micro>(Real(-1))));
+  }
+
+  TEST_CASE("Batch sincos, atan2") {
+    std::vector<double> x, y;
+    for (int i = 0; i < 1000; ++i) {
+      x.push_back(i * 0.1 - 50);
+      y.push_back(i % 13 - 6);
+    }
+    std::vector<double> s(x.size()), c(x.size()), a(x.size());
+    sincos<Accuracy::Nano>(x.data(), s.data(), c.data(), x.size());
+    atan2<Accuracy::Nano>(y.data(), x.data(), a.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+      CHECK(std::fabs(s[i] - std::sin(x[i])) < 1e-9);
+      CHECK(std::fabs(c[i] - std::cos(x[i])) < 1e-9);
+      CHECK(std::fabs(a[i] - std::atan2(y[i], x[i])) < 1e-9);
+    }
+    std::vector<Real> rx(x.begin(), x.end()), rs(x.size()), rc(x.size());
+    sincos<Accuracy::Libm>(rx.data(), rs.data(), rc.data(), rx.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+      CHECK(rs[i] == std::sin(x[i]));
+      CHECK(rc[i] == std::cos(x[i]));
+    }
+
+    // Non-finite arguments give NaN, as with libm.
+    std::vector<double> special{std::numeric_limits<double>::quiet_NaN(),
+                                std::numeric_limits<double>::infinity(),
+                                -std::numeric_limits<double>::infinity()};
+    std::vector<double> ss(special.size()), sc(special.size());
+    sincos<Accuracy::Nano>(special.data(), ss.data(), sc.data(), ss.size());
+    for (size_t i = 0; i < special.size(); ++i)
+      CHECK((std::isnan(ss[i]) && std::isnan(sc[i])));
+    sincos<Accuracy::Micro>(special.data(), ss.data(), sc.data(), ss.size());
+    for (size_t i = 0; i < special.size(); ++i)
+      CHECK((std::isnan(ss[i]) && std::isnan(sc[i])));
+  }
+
   TEST_CASE("sign") {
     CHECK(sign(11) == 1);
     CHECK(sign(-3) == -1);
@@ -267,6 +355,59 @@ TEST_SUITE("Geometry::Real") {
     CHECK((double)a == Approx(89.1));
     CHECK((long double)a == Approx(89.1));
   }
+
+  TEST_CASE("Array comparisons") {
+    // Differences around eps, on both sides of each boundary.
+    std::vector<Real> x, y;
+    std::vector<double> dx, dy;
+    const double offsets[] = {0,     1e-10, 5e-10, 9e-10, 1.1e-9,
+                              2e-9,  1e-6,  -1e-10, -9e-10, -1.1e-9,
+                              -1e-6, 1,     -1};
+    for (double base : {0.0, 1.0, -3.5, 1e3})
+      for (double offset : offsets) {
+        x.push_back(base);
+        y.push_back(Real(base) + Real(offset));
+        dx.push_back(base);
+        dy.push_back(base + offset);
+      }
+    const size_t n = x.size();
+    std::vector<uint8_t> mask(n), scalar(n), doubleMask(n);
+
+    auto check = [&](auto c, auto op) {
+      constexpr Comparison C = decltype(c)::value;
+      compare<C>(x.data(), y.data(), mask.data(), n);
+      compare<C>(dx.data(), dy.data(), doubleMask.data(), n);
+      for (size_t i = 0; i < n; ++i) {
+        CHECK(mask[i] == op(x[i], y[i]));
+        CHECK(doubleMask[i] == detail::epsilonCompare<C>(dx[i], dy[i], 1e-9));
+      }
+      compare<C>(x.data(), Real(1), mask.data(), n);
+      for (size_t i = 0; i < n; ++i)
+        CHECK(mask[i] == op(x[i], Real(1)));
+    };
+    using C = Comparison;
+    check(std::integral_constant<C, C::Equal>(),
+          [](Real a, Real b) { return a == b; });
+    check(std::integral_constant<C, C::NotEqual>(),
+          [](Real a, Real b) { return a != b; });
+    check(std::integral_constant<C, C::Less>(),
+          [](Real a, Real b) { return a < b; });
+    check(std::integral_constant<C, C::Greater>(),
+          [](Real a, Real b) { return a > b; });
+    check(std::integral_constant<C, C::LessEqual>(),
+          [](Real a, Real b) { return a <= b; });
+    check(std::integral_constant<C, C::GreaterEqual>(),
+          [](Real a, Real b) { return a >= b; });
+
+    // Blocks and the remainder, for a length not a multiple of 16.
+    std::vector<double> ramp(37);
+    for (size_t i = 0; i < ramp.size(); ++i)
+      ramp[i] = static_cast<double>(i);
+    std::vector<uint8_t> below(ramp.size());
+    compare<Comparison::Less>(ramp.data(), 20.0, below.data(), ramp.size());
+    for (size_t i = 0; i < ramp.size(); ++i)
+      CHECK(below[i] == (i < 20));
+  }
 }
 
 TEST_SUITE("Geometry::Vector") {
@@ -568,6 +709,94 @@ TEST_SUITE("Geometry::Vector") {
   }
 }
 
+TEST_SUITE("Geometry::CompactVector") {
+  TEST_CASE("Layout") {
+    static_assert(sizeof(IVector) == 8);
+    static_assert(sizeof(SVector) == 4);
+    IPoint A(-3, 4);
+    CHECK(LVector(A) == LVector(-3, 4));
+    CHECK(SVector(A) == SVector(-3, 4));
+  }
+
+  TEST_CASE("Wide products") {
+    constexpr int32_t big = std::numeric_limits<int32_t>::max();
+    IVector a(big, -big), b(big, big);
+    static_assert(std::is_same<decltype(wideCross(a, b)), __int128>::value);
+    CHECK(wideCross(a, b) == 2 * int64_t(big) * big);
+    CHECK(wideDot(a, b) == 0);
+    CHECK(wideLen2(a) == 2 * int64_t(big) * big);
+
+    // Sums of two products reach 2^63 at the minimum.
+    constexpr int32_t small = std::numeric_limits<int32_t>::min();
+    IVector m(small, small), n(small, big);
+    CHECK(wideDot(m, m) == __int128(1) << 63);
+    CHECK(wideLen2(m) == __int128(1) << 63);
+    CHECK(wideCross(m, IVector(big, small)) ==
+          (__int128(1) << 63) - (__int128(1) << 31));
+    CHECK(wideCross(m, n) == -(__int128(small) * small) * 2 - small);
+    CHECK(wideDot(IVector(small, big), IVector(small, big)) ==
+          (__int128(1) << 62) + __int128(big) * big);
+    using ShortProduct = decltype(wideCross(SVector(), SVector()));
+    static_assert(std::is_same<ShortProduct, int64_t>::value);
+
+    SVector c(-32768, -32768), d(32767, -32768);
+    CHECK(wideCross(c, d) == int64_t(-32768) * -32768 * 2 - 32768);
+    CHECK(wideDot(c, d) == int64_t(-32768) * 32767 + int64_t(32768) * 32768);
+
+    LVector e(int64_t(1) << 62, 1), f(1, int64_t(1) << 62);
+    CHECK(wideCross(e, f) == (__int128(1) << 124) - 1);
+    static_assert(wideCross(SVector(1, 0), SVector(0, 1)) == 1);
+  }
+
+  TEST_CASE("Quantizer") {
+    auto grid = Quantizer<int16_t>::fit({-10, 5}, {10, 15});
+    CHECK(static_cast<double>(grid.step()) == Approx(20.0 / 32766));
+    CHECK(grid.quantize({0, 10}) == SPoint(0, 0));
+    CHECK(grid.quantize({10, 10}) == SPoint(16383, 0));
+    CHECK(grid.quantize({-10, 5}) == SPoint(-16383, -8192));
+    // Outside of the box, clamped.
+    CHECK(grid.quantize({1e9, -1e9}) == SPoint(16383, -16383));
+    // NaN to the center.
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    CHECK(grid.quantize({nan, 15}) == SPoint(0, 8192));
+
+    std::vector<RPoint> points;
+    for (int i = 0; i < 100; ++i)
+      points.emplace_back(-10 + 0.2 * i, 5 + 0.1 * i);
+    std::vector<SPoint> quantized(points.size());
+    std::vector<RPoint> restored(points.size());
+    grid.quantize(points.data(), quantized.data(), points.size());
+    grid.dequantize(quantized.data(), restored.data(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      CHECK(quantized[i] == grid.quantize(points[i]));
+      CHECK(static_cast<double>(fabs(restored[i].x() - points[i].x())) <=
+            static_cast<double>(grid.step()) / 2 + 1e-12);
+      CHECK(static_cast<double>(fabs(restored[i].y() - points[i].y())) <=
+            static_cast<double>(grid.step()) / 2 + 1e-12);
+    }
+
+    // Differences of quantized points do not overflow.
+    SPoint lo = grid.quantize({-1e9, -1e9}), hi = grid.quantize({1e9, 1e9});
+    CHECK(LVector(hi - lo) == LVector(32766, 32766));
+  }
+
+  TEST_CASE("Quantized orientation") {
+    auto grid = Quantizer<int32_t>::fit({0, 0}, {1, 1});
+    IPoint A = grid.quantize({0.1, 0.1}), B = grid.quantize({0.9, 0.2}),
+           C = grid.quantize({0.5, 0.8});
+    CHECK(wideCross(B - A, C - A) > 0);
+    CHECK(wideCross(C - A, B - A) < 0);
+    CHECK(wideCross(B - A, B - A) == 0);
+  }
+
+  TEST_CASE("Degenerate box") {
+    auto grid = Quantizer<int32_t>::fit({3, 3}, {3, 3});
+    CHECK(grid.step() > 0);
+    CHECK(grid.quantize({3, 3}) == IPoint(0, 0));
+    CHECK(grid.dequantize({0, 0}) == RPoint(3, 3));
+  }
+}
+
 TEST_SUITE("Geometry::Line") {
   TEST_CASE("Constructors") {
     Line<int32_t> l{1, 2, 3};
@@ -631,3 +860,155 @@ TEST_SUITE("Geometry::Line") {
     CHECK_FALSE(l.parallelTo({1, 1, 1}));
   }
 }
+
+TEST_SUITE("Geometry::constexpr") {
+  constexpr LVector u{3, -4};
+  static_assert(u.x() == 3 && u.y() == -4);
+  static_assert(u + LVector(1, 1) == LVector(4, -3));
+  static_assert(u - LVector(1, 1) == LVector(2, -5));
+  static_assert(-u == LVector(-3, 4));
+  static_assert(u * 2 == LVector(6, -8));
+  static_assert(2 * u == LVector(6, -8));
+  static_assert(u / 3 == LVector(1, -1));
+  static_assert((u ^ LVector(1, 1)) == -1);
+  static_assert(u % LVector(1, 1) == 7);
+  static_assert(u.len2() == 25);
+  static_assert(u.rotatedClockwise() == LVector(-4, -3));
+  static_assert(u.rotatedCounterclockwise() == LVector(4, 3));
+  static_assert(LVector(u).rotateClockwise() == LVector(-4, -3));
+  static_assert(LVector(u).rotateCounterclockwise() == LVector(4, 3));
+  static_assert(LVector(LPoint(1, 2), LPoint(4, -2)) == u);
+  static_assert(LVector(1, 2) < LVector(3, -100000));
+  static_assert(LVector(4, -1) >= LVector(4, -1));
+  static_assert(!(LVector(3, 0) < LVector(3, -1)));
+  static_assert(dist2(LPoint(4, 10), LPoint(5, 12)) == 5);
+  static_assert(normalized(LVector{-4, 6}) == LVector{2, -3});
+  static_assert(RVector(0.1, 0.2) + RVector(0.2, 0.1) == RVector(0.3, 0.3));
+
+  constexpr Matrix<int64_t> m{1, 2, 3, 4};
+  static_assert(m.det() == -2);
+  static_assert(m * LVector(1, 1) == LVector(3, 7));
+  static_assert(LVector(1, 1) * m == LVector(4, 6));
+  static_assert((m + m).d() == 8);
+  static_assert((m - m).a() == 0);
+  static_assert((-m).b() == -2);
+  static_assert((m * 3).c() == 9);
+  static_assert(Matrix<Real>(m).a() == 1);
+  static_assert(Matrix<int64_t>().det() == 0);
+
+  constexpr LLine l{LPoint(0, 0), LPoint(5, -9)};
+  static_assert(l.relativePosition({0, 0}) == 0);
+  static_assert(l.relativePosition({1, 1}) == -1);
+  static_assert(l.contains({10, -18}));
+  static_assert(l.parallelTo({-9, -5, 7}));
+  static_assert(LLine().c() == 0);
+
+  constexpr auto directions = unitDirections<12>();
+  static_assert(directions[0] == RVector(1, 0));
+  static_assert(directions[3] == RVector(0, 1));
+  static_assert(directions[6] == RVector(-1, 0));
+  static_assert(directions[9] == RVector(0, -1));
+  static_assert(directions[2] == RVector(0.5, 0.8660254037844386));
+
+  constexpr auto rotations = rotationMatrices<4>();
+  static_assert(rotations[1] * RVector(1, 0) == RVector(0, 1));
+  static_assert(rotations[2] * RVector(3, 4) == RVector(-3, -4));
+  static_assert(rotations[3].det() == 1);
+
+  static_assert(stencil4[1] == LVector(0, 1));
+  static_assert(stencil8[5] == LVector(-1, -1));
+
+  TEST_CASE("unitDirections agree with std::cos, std::sin") {
+    constexpr size_t N = 360;
+    constexpr auto table = unitDirections<N>();
+    for (size_t k = 0; k < N; ++k) {
+      long double angle = 2 * std::acos(-1.0l) * k / N;
+      CHECK((long double)table[k].x() == Approx(std::cos(angle)));
+      CHECK((long double)table[k].y() == Approx(std::sin(angle)));
+      CHECK(table[k].x() == std::cos(angle));
+      CHECK(table[k].y() == std::sin(angle));
+    }
+  }
+
+  TEST_CASE("rotationMatrices agree with unitDirections") {
+    constexpr auto directions = unitDirections<24>();
+    constexpr auto rotations = rotationMatrices<24>();
+    for (size_t k = 0; k < 24; ++k)
+      CHECK(rotations[k] * directions[0] == directions[k]);
+  }
+}
+
+TEST_SUITE("Geometry::Matrix") {
+  TEST_CASE("Multiplication") {
+    Matrix<int64_t> m{1, 2, 3, 4};
+    Matrix<int64_t> n{0, 1, -1, 5};
+    CHECK(m * n == Matrix<int64_t>{-2, 11, -4, 23});
+    CHECK(n * m == Matrix<int64_t>{3, 4, 14, 18});
+    CHECK(m * Matrix<int64_t>::identity() == m);
+    m *= n;
+    CHECK(m == Matrix<int64_t>{-2, 11, -4, 23});
+    Matrix<Real> r{0.5, 0, 0, 2};
+    CHECK(r * Matrix<Real>{2, 0, 0, 0.5} == Matrix<Real>::identity());
+  }
+
+  TEST_CASE("pow") {
+    Matrix<int64_t> fib{1, 1, 1, 0};
+    CHECK(pow(fib, 0) == Matrix<int64_t>::identity());
+    CHECK(pow(fib, 1) == fib);
+    CHECK(pow(fib, 10).b() == 55);
+    CHECK(pow(fib, 90).b() == 2'880'067'194'370'816'120ll);
+    Matrix<Real> quarterTurn{0, -1, 1, 0};
+    CHECK(pow(quarterTurn, 4) == Matrix<Real>::identity());
+    CHECK(pow(quarterTurn, 1'000'000'002) * RVector(1, 0) == RVector(-1, 0));
+  }
+
+  TEST_CASE("mulMod, powMod") {
+    const int64_t mod = 1'000'000'007;
+    Matrix<int64_t> fib{1, 1, 1, 0};
+    CHECK(mulMod(fib, fib, mod) == fib * fib);
+    CHECK(powMod(fib, 10, mod).b() == 55);
+    CHECK(powMod(fib, 90, mod).b() == 2'880'067'194'370'816'120ll % mod);
+    CHECK(powMod(fib, 1'000'000'000'000'000'000ull, mod).b() == 209'783'453);
+    const int64_t bigMod = (1ll << 62) + 135;
+    Matrix<int64_t> big{bigMod - 1, 0, 0, bigMod - 1};
+    CHECK(mulMod(big, big, bigMod) == Matrix<int64_t>::identity());
+    CHECK(powMod(fib, 0, int64_t(1)) == Matrix<int64_t>());
+
+    // Entries outside [0, mod) are reduced first.
+    Matrix<int64_t> negative{-1, 1, 1, 0};
+    CHECK(mulMod(negative, negative, mod) == Matrix<int64_t>{2, mod - 1,
+                                                             mod - 1, 1});
+    CHECK(powMod(negative, 3, mod) == Matrix<int64_t>{mod - 3, 2, 2, mod - 1});
+    CHECK(powMod(fib * (mod + 1), 90, mod) == powMod(fib, 90, mod));
+    Matrix<int64_t> minusThree{-3, 0, 0, -3};
+    CHECK(mulMod(minusThree, minusThree, bigMod) ==
+          Matrix<int64_t>{9, 0, 0, 9});
+  }
+
+  TEST_CASE("multiplyBatch") {
+    std::vector<Matrix<int64_t>> lhs, rhs, out(100);
+    for (int64_t i = 0; i < 100; ++i) {
+      lhs.push_back({i, 1, 0, i});
+      rhs.push_back({1, -i, 2, 3});
+    }
+    multiplyBatch(lhs.data(), rhs.data(), out.data(), out.size());
+    for (size_t i = 0; i < out.size(); ++i)
+      CHECK(out[i] == lhs[i] * rhs[i]);
+    multiplyBatch(lhs.data(), rhs.data(), lhs.data(), lhs.size());
+    CHECK(lhs == out);
+  }
+
+  TEST_CASE("chainProduct") {
+    CHECK(chainProduct<int64_t>(nullptr, 0) == Matrix<int64_t>::identity());
+    for (size_t n = 1; n <= 17; ++n) {
+      std::vector<Matrix<int64_t>> chain;
+      Matrix<int64_t> expected = Matrix<int64_t>::identity();
+      for (size_t i = 0; i < n; ++i) {
+        Matrix<int64_t> m{1, int64_t(i), int64_t(i % 3), 1};
+        chain.push_back(m);
+        expected *= m;
+      }
+      CHECK(chainProduct(chain.data(), chain.size()) == expected);
+    }
+  }
+}
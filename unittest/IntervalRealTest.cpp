@@ -0,0 +1,161 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+
+#include "Geometry.hpp"
+#include "IntervalReal.hpp"
+#include "doctest.h"
+
+using namespace acmlib::geometry;
+using namespace acmlib::numeric;
+
+TEST_SUITE("Numeric::IntervalReal") {
+  TEST_CASE("Construction") {
+    IntervalReal zero;
+    CHECK(zero.isPoint());
+    CHECK(zero.contains(0));
+    IntervalReal exact = 0.5;
+    CHECK(exact.isPoint());
+    IntervalReal tenth = 0.1l;
+    CHECK_FALSE(tenth.isPoint());
+    CHECK(tenth.lower() <= 0.1l);
+    CHECK(tenth.upper() >= 0.1l);
+    IntervalReal big = (int64_t(1) << 60) + 1;
+    CHECK_FALSE(big.isPoint());
+    CHECK(big.lower() < big.upper());
+    IntervalReal fromReal = Real(3);
+    CHECK(fromReal.isPoint());
+    CHECK((double)fromReal == 3);
+  }
+
+  TEST_CASE("Bounds contain the exact result") {
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> value(-1e3, 1e3);
+    for (int i = 0; i < 10000; ++i) {
+      double a = value(rng), b = value(rng), c = value(rng);
+      IntervalReal x = IntervalReal(a) * b + c;
+      long double expected = (long double)a * b + c;
+      CHECK(x.lower() <= expected);
+      CHECK(x.upper() >= expected);
+      IntervalReal y = IntervalReal(a) / b - c;
+      long double expectedQuotient = (long double)a / b - c;
+      CHECK(y.lower() <= expectedQuotient);
+      CHECK(y.upper() >= expectedQuotient);
+    }
+    IntervalReal third = IntervalReal(1) / 3;
+    CHECK(third.lower() < third.upper());
+    CHECK((third * 3).contains(1));
+    IntervalReal root = sqrt(IntervalReal(2));
+    CHECK(root.lower() * root.lower() <= 2);
+    CHECK(root.upper() * root.upper() >= 2);
+    CHECK(sqrt(IntervalReal(4)).contains(2));
+    CHECK((IntervalReal(1) / IntervalReal::fromBounds(-1, 1)).contains(1e300));
+    CHECK(fabs(IntervalReal::fromBounds(-3, 2)).upper() == 3);
+  }
+
+  TEST_CASE("Overflow and underflow") {
+    const double largest = std::numeric_limits<double>::max();
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    // Factors whose splitting overflows without FMA.
+    double a = 0x1.0000000000001p1000, b = 0x1.0000000000001p0;
+    IntervalReal product = IntervalReal(a) * IntervalReal(b);
+    CHECK(product.lower() <= 0x1.0000000000002p1000);
+    CHECK(product.upper() > 0x1.0000000000002p1000);
+    CHECK(product.upper() < infinity);
+
+    // Products underflowing to zero keep an uncertain sign.
+    for (double sign : {1.0, -1.0}) {
+      IntervalReal tiny = IntervalReal(sign * 1e-200) * IntervalReal(1e-200);
+      CHECK(tiny.contains(0));
+      CHECK(!tiny.isPoint());
+      CHECK(!certifiedSign(tiny).certain);
+      CHECK(tiny.lower() < 0);
+      CHECK(tiny.upper() > 0);
+    }
+    IntervalReal denormal = IntervalReal(0x1p-600) * IntervalReal(0x1.8p-460);
+    CHECK(denormal.lower() <= 0x1.8p-1060);
+    CHECK(denormal.upper() >= 0x1.8p-1060);
+    CHECK(certifiedSign(IntervalReal(0) * IntervalReal(1e-200)).certain);
+
+    // Sums and products beyond the largest double.
+    IntervalReal sum = IntervalReal(largest) + IntervalReal(largest);
+    CHECK(sum.lower() == largest);
+    CHECK(sum.upper() == infinity);
+    CHECK(certifiedSign(sum).value == 1);
+    IntervalReal negative = -IntervalReal(largest) * IntervalReal(2);
+    CHECK(negative.lower() == -infinity);
+    CHECK(negative.upper() == -largest);
+    CHECK(certifiedSign(negative).value == -1);
+
+    // Infinite bounds, and zero times infinity.
+    IntervalReal line = IntervalReal(1) / IntervalReal::fromBounds(-1, 1);
+    IntervalReal scaled = line * IntervalReal(0);
+    CHECK(scaled.lower() == -infinity);
+    CHECK(scaled.upper() == infinity);
+    CHECK((line + IntervalReal(1)).contains(0));
+  }
+
+  TEST_CASE("Exact operations stay points") {
+    IntervalReal x = 3;
+    x = x * 7 - 1;
+    CHECK(x.isPoint());
+    CHECK(x.lower() == 20);
+    CHECK((IntervalReal(0.25) + 0.5).isPoint());
+  }
+
+  TEST_CASE("Certain comparisons and signs") {
+    IntervalReal a = IntervalReal::fromBounds(1, 2);
+    IntervalReal b = IntervalReal::fromBounds(1.5, 3);
+    IntervalReal c = IntervalReal::fromBounds(2.5, 3);
+    CHECK(a == b);
+    CHECK_FALSE(a < b);
+    CHECK(a < c);
+    CHECK(c > a);
+    CHECK(sign(a) == 1);
+    CHECK(sign(-a) == -1);
+    CHECK(sign(a - b) == 0);
+    CHECK(certifiedSign(a).certain);
+    CHECK(certifiedSign(a).value == 1);
+    CHECK_FALSE(certifiedSign(a - b).certain);
+    CHECK(certifiedSign(IntervalReal()).certain);
+    CHECK(certifiedSign(IntervalReal()).value == 0);
+  }
+
+  TEST_CASE("Filtered orientation predicate") {
+    auto orientation = [](LPoint A, LPoint B, LPoint C, int &exactCalls) {
+      using IVector = Vector<IntervalReal>;
+      IntervalReal approximation =
+          (IVector(B) - IVector(A)) % (IVector(C) - IVector(A));
+      return filteredSign(approximation, [&] {
+        ++exactCalls;
+        return sign(Vector<__int128>(B - A) % Vector<__int128>(C - A));
+      });
+    };
+    int exactCalls = 0;
+    CHECK(orientation({0, 0}, {1, 0}, {0, 1}, exactCalls) == 1);
+    CHECK(orientation({0, 0}, {0, 1}, {1, 0}, exactCalls) == -1);
+    CHECK(orientation({0, 0}, {1, 1}, {2, 2}, exactCalls) == 0);
+    CHECK(exactCalls == 0);
+    // Doubles cannot represent these coordinates exactly.
+    const int64_t big = (int64_t(1) << 60) + 1;
+    CHECK(orientation({0, 0}, {big, big - 1}, {big - 1, big - 2},
+                      exactCalls) == -1);
+    CHECK(exactCalls == 1);
+  }
+
+  TEST_CASE("Vector and Line with interval coordinates") {
+    using IVector = Vector<IntervalReal>;
+    IVector a{0.1l, 0.2l}, b{0.3l, 0.6l};
+    CHECK(a.parallelTo(b));
+    CHECK(sign(a % b) == 0);
+    CHECK(a.len() == std::sqrt(0.05l));
+    Line<IntervalReal> l{IVector(0, 0), IVector(1, 3)};
+    CHECK(l.relativePosition({1, 0}) == 1);
+    CHECK(l.relativePosition({0.1l, 0.3l}) == 0);
+    std::ostringstream os;
+    os << IntervalReal(0.5);
+    CHECK(os.str() == "[0.5, 0.5]");
+  }
+}
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "Geometry.hpp"
+#include "doctest.h"
+
+using namespace acmlib::geometry;
+
+// Built into acmlib-test-counting, where
+// ACMLIB_COUNT_OPERATIONS is defined.
+TEST_SUITE("Geometry::OperationCounts") {
+  TEST_CASE("Real operations") {
+    OperationCountScope scope;
+    Real a = 1.5, b = 2;
+    Real c = a * b + a / b - -a;
+    ++c;
+    CHECK(scope.counts().arithmetic == 6);
+    CHECK(scope.counts().comparisons == 0);
+
+    bool less = a < b;
+    CHECK(less);
+    CHECK(scope.counts().comparisons == 1);
+    CHECK(scope.counts().ambiguous == 0);
+
+    // Below eps: equal, but only thanks to eps.
+    bool equal = Real(1) == Real(1 + 1e-10l);
+    CHECK(equal);
+    // Just above eps: different, but only barely.
+    bool different = Real(1) != Real(1 + 2e-9l);
+    CHECK(different);
+    // Exactly equal, and clearly different.
+    bool same = Real(1) == Real(1);
+    bool greater = Real(2) > Real(1);
+    CHECK((same && greater));
+    CHECK(scope.counts().comparisons == 5);
+    CHECK(scope.counts().ambiguous == 2);
+
+    Real root = sqrt(b) + atan2(a, b);
+    (void)root;
+    CHECK(scope.counts().libm == 2);
+    Real fast = sqrt<Accuracy::Nano>(b);
+    (void)fast;
+    CHECK(scope.counts().libm == 2);
+  }
+
+  TEST_CASE("Vector operations") {
+    OperationCountScope scope;
+    LVector u(1, 2), v(3, 4);
+    int64_t cross = (u + v) % (u - v);
+    CHECK(cross == 4);
+    CHECK(scope.counts().vector == 3);
+    CHECK(scope.counts().arithmetic == 0);
+
+    RVector p(1, 2), q(3, 4);
+    Real dot = p ^ q;
+    CHECK(dot == 11);
+    CHECK(scope.counts().vector == 4);
+    CHECK(scope.counts().arithmetic == 3);
+  }
+
+  TEST_CASE("Scopes nest") {
+    OperationCountScope outer;
+    std::vector<Real> values(100);
+    for (size_t i = 0; i < values.size(); ++i)
+      values[i] = Real(i % 10) * Real(0.5);
+    {
+      OperationCountScope inner;
+      std::sort(values.begin(), values.end());
+      CHECK(inner.counts().comparisons > 0);
+      CHECK(inner.counts().arithmetic == 0);
+    }
+    CHECK(outer.counts().arithmetic == 100);
+    CHECK(outer.counts().comparisons > 0);
+  }
+
+  TEST_CASE("Constant evaluation is not counted") {
+    OperationCountScope scope;
+    constexpr LVector u = LVector(1, 2) + LVector(3, 4);
+    static_assert(u.x() == 4);
+    constexpr bool less = Real(1) < Real(2);
+    static_assert(less);
+    CHECK(scope.counts().vector == 0);
+    CHECK(scope.counts().comparisons == 0);
+  }
+}
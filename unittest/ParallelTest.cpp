@@ -0,0 +1,140 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "FastIO.hpp"
+#include "Parallel.hpp"
+#include "doctest.h"
+
+using namespace acmlib::parallel;
+
+TEST_SUITE("Parallel::ThreadPool") {
+  TEST_CASE("Task groups") {
+    for (size_t workers : {0, 1, 3}) {
+      ThreadPool pool(workers);
+      CHECK(pool.size() == workers + 1);
+      std::atomic<int64_t> sum{0};
+      TaskGroup group(pool);
+      for (int64_t i = 1; i <= 1000; ++i)
+        group.run([&sum, i] { sum += i; });
+      group.wait();
+      CHECK(sum == 500500);
+    }
+  }
+
+  TEST_CASE("Nested fork/join") {
+    ThreadPool pool(2);
+    std::atomic<int32_t> leaves{0};
+    TaskGroup outer(pool);
+    for (int i = 0; i < 8; ++i)
+      outer.run([&] {
+        TaskGroup inner(pool);
+        for (int j = 0; j < 8; ++j)
+          inner.run([&] { ++leaves; });
+        inner.wait();
+      });
+    outer.wait();
+    CHECK(leaves == 64);
+  }
+
+  TEST_CASE("Exceptions") {
+    ThreadPool pool(2);
+    std::atomic<int32_t> finished{0};
+    TaskGroup group(pool);
+    for (int i = 0; i < 10; ++i)
+      group.run([&, i] {
+        if (i == 5)
+          throw std::runtime_error("task");
+        ++finished;
+      });
+    CHECK_THROWS_AS(group.wait(), std::runtime_error);
+    CHECK(finished == 9);
+    group.run([&] { ++finished; });
+    CHECK_NOTHROW(group.wait());
+    CHECK(finished == 10);
+  }
+
+  TEST_CASE("parallelFor") {
+    for (size_t workers : {0, 3}) {
+      ThreadPool pool(workers);
+      for (size_t grain : {1, 7, 1000}) {
+        std::vector<int32_t> hits(5000);
+        std::atomic<bool> oversized{false};
+        parallelFor(
+            10, hits.size(),
+            [&](size_t begin, size_t end) {
+              if (end - begin > grain)
+                oversized = true;
+              for (size_t i = begin; i < end; ++i)
+                ++hits[i];
+            },
+            grain, pool);
+        CHECK(!oversized);
+        for (size_t i = 0; i < hits.size(); ++i)
+          CHECK(hits[i] == (i >= 10));
+      }
+      parallelFor(
+          5, 5, [](size_t, size_t) { FAIL("empty range"); }, 1, pool);
+    }
+  }
+
+  TEST_CASE("parallelReduce") {
+    for (size_t workers : {0, 3}) {
+      ThreadPool pool(workers);
+      auto sum = [](size_t begin, size_t end) {
+        int64_t result = 0;
+        for (size_t i = begin; i < end; ++i)
+          result += i;
+        return result;
+      };
+      auto plus = [](int64_t a, int64_t b) { return a + b; };
+      CHECK(parallelReduce(1, 1001, int64_t(0), sum, plus, 16, pool) ==
+            500500);
+      CHECK(parallelReduce(7, 7, int64_t(-1), sum, plus, 16, pool) == -1);
+
+      // Blocks are folded in order with fixed boundaries.
+      auto bounds = [](size_t begin, size_t end) {
+        return std::to_string(begin) + "-" + std::to_string(end) + ";";
+      };
+      auto concat = [](std::string a, std::string b) { return a + b; };
+      CHECK(parallelReduce(2, 12, std::string(), bounds, concat, 4, pool) ==
+            "2-6;6-10;10-12;");
+    }
+  }
+
+  TEST_CASE("parallelInvoke") {
+    std::atomic<int32_t> a{0}, b{0}, c{0};
+    parallelInvoke([&] { a = 1; }, [&] { b = 2; }, [&] { c = 3; });
+    CHECK(a + b + c == 6);
+  }
+
+  TEST_CASE("solveInParallel") {
+    ThreadPool pool(3);
+    std::ostringstream os;
+    solveInParallel(
+        5, [](size_t i, std::ostream &out) { out << i * i << '\n'; }, os,
+        pool);
+    CHECK(os.str() == "0\n1\n4\n9\n16\n");
+
+    // Through a Writer, in order with its other output.
+    std::FILE *file = std::tmpfile();
+    REQUIRE(file);
+    {
+      acmlib::io::Writer out(file);
+      out << "cases\n";
+      solveInParallel(
+          3, [](size_t i, std::ostream &answer) { answer << i << '\n'; },
+          out, pool);
+      out << "done\n";
+    }
+    std::string text(std::ftell(file), '\0');
+    std::rewind(file);
+    CHECK(std::fread(&text[0], 1, text.size(), file) == text.size());
+    std::fclose(file);
+    CHECK(text == "cases\n0\n1\n2\ndone\n");
+  }
+}
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Geometry.hpp"
+#include "PointDedup.hpp"
+#include "PointGenerator.hpp"
+#include "doctest.h"
+
+using namespace acmlib::geometry;
+
+TEST_SUITE("Geometry::PointDedup") {
+  TEST_CASE("Exact deduplication") {
+    std::vector<LPoint> points{{3, 1}, {1, 2}, {3, 1}, {-5, 0}, {1, 2}, {1, 2}};
+    deduplicate(points);
+    CHECK(points == std::vector<LPoint>{{-5, 0}, {1, 2}, {3, 1}});
+
+    std::vector<LPoint> none;
+    deduplicate(none);
+    CHECK(none.empty());
+
+    for (auto E : {0, 1}) {
+      auto random = generatePoints<int64_t>(Distribution::UniformSquare,
+                                            100000, 3, 100);
+      auto expected = random;
+      std::sort(expected.begin(), expected.end());
+      expected.erase(std::unique(expected.begin(), expected.end()),
+                     expected.end());
+      if (E)
+        deduplicate<Execution::Parallel>(random);
+      else
+        deduplicate(random);
+      CHECK(random == expected);
+    }
+
+    std::vector<IPoint> compact(1000, IPoint(7, -7));
+    compact.push_back(IPoint(-7, 7));
+    deduplicate(compact);
+    CHECK(compact == std::vector<IPoint>{{-7, 7}, {7, -7}});
+  }
+
+  TEST_CASE("Near duplicates") {
+    std::vector<RPoint> points{{0, 0},         {1, 1},     {1e-10, -1e-10},
+                               {1, 1 + 5e-10}, {0, 2e-9},  {0.5, 0.5},
+                               {-1e-10, 0},    {1, 1}};
+    mergeNearDuplicates(points);
+    REQUIRE(points.size() == 4);
+    CHECK(bool(points[0] == RPoint(0, 0)));
+    CHECK(bool(points[1] == RPoint(1, 1)));
+    CHECK(bool(points[2] == RPoint(0, 2e-9)));
+    CHECK(bool(points[3] == RPoint(0.5, 0.5)));
+    CHECK(static_cast<double>(points[0].x()) == 0);
+
+    // Pairs straddling cell boundaries on either axis.
+    std::vector<RPoint> straddling;
+    for (int k = -3; k <= 3; ++k) {
+      double boundary = k * 4e-9, offset = (k + 10) * 1e-6;
+      straddling.emplace_back(boundary - 0.45e-9, offset);
+      straddling.emplace_back(boundary + 0.45e-9, offset);
+      straddling.emplace_back(-offset, boundary + 0.45e-9);
+      straddling.emplace_back(-offset, boundary - 0.45e-9);
+    }
+    mergeNearDuplicates(straddling);
+    CHECK(straddling.size() == 14);
+  }
+
+  TEST_CASE("Chains are not collapsed") {
+    // Each point is within eps of the next, not of the one after.
+    std::vector<RPoint> chain;
+    for (int i = 0; i < 10; ++i)
+      chain.emplace_back(i * 0.6e-9, 0);
+    mergeNearDuplicates(chain);
+    REQUIRE(chain.size() == 5);
+    for (size_t i = 0; i < chain.size(); ++i)
+      CHECK(static_cast<double>(chain[i].x()) == doctest::Approx(i * 1.2e-9));
+    for (size_t i = 0; i + 1 < chain.size(); ++i)
+      CHECK(bool(chain[i] != chain[i + 1]));
+  }
+
+  TEST_CASE("Dirty input") {
+    // Distinct points, each repeated with noise below eps / 4,
+    // around cell boundaries too.
+    std::mt19937_64 rng(5);
+    std::uniform_real_distribution<double> noise(-0.25e-9, 0.25e-9);
+    auto clean = generatePoints<double>(Distribution::JitteredGrid, 2000, 1,
+                                        1e-3);
+    std::vector<RPoint> dirty;
+    for (int copy = 0; copy < 3; ++copy)
+      for (auto P : clean)
+        dirty.emplace_back(P.x() + (copy ? noise(rng) : 0),
+                           P.y() + (copy ? noise(rng) : 0));
+    std::shuffle(dirty.begin(), dirty.end(), rng);
+
+    for (auto E : {0, 1}) {
+      auto merged = dirty;
+      if (E)
+        mergeNearDuplicates<Execution::Parallel>(merged);
+      else
+        mergeNearDuplicates(merged);
+      CHECK(merged.size() == clean.size());
+      size_t equalPairs = 0;
+      for (size_t i = 0; i < merged.size(); ++i)
+        for (size_t j = i + 1; j < merged.size(); ++j)
+          equalPairs += merged[i] == merged[j];
+      CHECK(equalPairs == 0);
+      // Kept points are the first of their group, in input order.
+      CHECK(bool(merged[0] == dirty[0]));
+    }
+  }
+}
@@ -0,0 +1,133 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "Geometry.hpp"
+#include "PointFile.hpp"
+#include "doctest.h"
+
+using namespace acmlib::geometry;
+using namespace acmlib::io;
+
+TEST_SUITE("IO::PointFile") {
+  // A temporary file name, removed at the end of the scope.
+  struct TemporaryPath {
+    std::string path;
+    TemporaryPath() {
+      char name[] = "/tmp/acmlib-pointfile-XXXXXX";
+      close(mkstemp(name));
+      path = name;
+    }
+    ~TemporaryPath() { std::remove(path.c_str()); }
+  };
+
+  template <typename T>
+  std::vector<Point<T>> randomPoints(size_t n) {
+    std::mt19937_64 rng(38);
+    std::vector<Point<T>> points(n);
+    for (auto &P : points)
+      P = {T(int32_t(rng()) / 3), T(int32_t(rng()) / 5)};
+    return points;
+  }
+
+  TEST_CASE_TEMPLATE("Round trip", T, int32_t, int64_t, float, double) {
+    TemporaryPath file;
+    std::vector<Point<T>> expected = randomPoints<T>(1001);
+
+    writePointFile(file.path, expected.data(), expected.size());
+    PointFile interleaved(file.path);
+    CHECK(interleaved.type() == coordinateTypeOf<T>());
+    CHECK(interleaved.layout() == Layout::Interleaved);
+    CHECK(interleaved.size() == expected.size());
+    CHECK(interleaved.polygonCount() == 0);
+    Span<Point<T>> points = interleaved.points<T>();
+    CHECK(std::vector<Point<T>>(points.begin(), points.end()) == expected);
+    CHECK_THROWS_AS(interleaved.columns<T>(), std::runtime_error);
+
+    writePointFile(file.path, expected.data(), expected.size(),
+                   Layout::Columns);
+    PointFile columns(file.path);
+    Columns<T> view = columns.columns<T>();
+    REQUIRE(view.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+      CHECK(view[i] == expected[i]);
+    CHECK(reinterpret_cast<uintptr_t>(view.y.data()) % 64 == 0);
+    CHECK_THROWS_AS(columns.points<T>(), std::runtime_error);
+  }
+
+  TEST_CASE("Polygons") {
+    TemporaryPath file;
+    std::vector<std::vector<LPoint>> polygons{
+        {{0, 0}, {4, 0}, {0, 3}}, {}, {{1, 1}, {2, 1}, {2, 2}, {1, 2}}};
+    writePointFile(file.path, polygons);
+    PointFile loaded(file.path);
+    CHECK(loaded.size() == 7);
+    REQUIRE(loaded.polygonCount() == 3);
+    for (size_t i = 0; i < polygons.size(); ++i) {
+      Span<LPoint> polygon = loaded.polygon<int64_t>(i);
+      CHECK(std::vector<LPoint>(polygon.begin(), polygon.end()) ==
+            polygons[i]);
+    }
+    CHECK_THROWS_AS(loaded.points<int32_t>(), std::runtime_error);
+  }
+
+  TEST_CASE("Malformed files") {
+    TemporaryPath file;
+    CHECK_THROWS_AS(PointFile(file.path), std::runtime_error);
+
+    std::vector<LPoint> points = randomPoints<int64_t>(10);
+    writePointFile(file.path, points.data(), points.size());
+    auto read = [&] {
+      std::string contents;
+      std::FILE *f = std::fopen(file.path.c_str(), "rb");
+      char c;
+      while (std::fread(&c, 1, 1, f) == 1)
+        contents.push_back(c);
+      std::fclose(f);
+      return contents;
+    };
+    std::string bytes = read();
+    auto rewrite = [&](std::string contents) {
+      std::FILE *f = std::fopen(file.path.c_str(), "wb");
+      std::fwrite(contents.data(), 1, contents.size(), f);
+      std::fclose(f);
+    };
+    rewrite(bytes.substr(0, bytes.size() - 1));
+    CHECK_THROWS_AS(PointFile(file.path), std::runtime_error);
+    std::string corrupted = bytes;
+    corrupted[0] = 'X';
+    rewrite(corrupted);
+    CHECK_THROWS_AS(PointFile(file.path), std::runtime_error);
+    rewrite(bytes);
+    CHECK_NOTHROW(PointFile(file.path));
+
+    // Offsets whose end wraps around below the length.
+    using Header = acmlib::io::detail::PointFileHeader;
+    auto withOffset = [](std::string contents, size_t field,
+                         uint64_t offset) {
+      std::memcpy(&contents[field], &offset, sizeof(offset));
+      return contents;
+    };
+    rewrite(withOffset(bytes, offsetof(Header, coordinatesOffset),
+                       ~uint64_t(0) - 127));
+    CHECK_THROWS_AS(PointFile(file.path), std::runtime_error);
+    // Coordinates overlapping the header.
+    rewrite(withOffset(bytes, offsetof(Header, coordinatesOffset), 0));
+    CHECK_THROWS_AS(PointFile(file.path), std::runtime_error);
+    std::vector<std::vector<LPoint>> polygons{{{0, 0}, {1, 0}, {0, 1}}};
+    writePointFile(file.path, polygons);
+    bytes = read();
+    CHECK_NOTHROW(PointFile(file.path));
+    rewrite(withOffset(bytes, offsetof(Header, polygonsOffset),
+                       ~uint64_t(0) - 63));
+    CHECK_THROWS_AS(PointFile(file.path), std::runtime_error);
+  }
+}
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Geometry.hpp"
+#include "PointGenerator.hpp"
+#include "PointStream.hpp"
+#include "doctest.h"
+
+using namespace acmlib::geometry;
+
+TEST_SUITE("Geometry::PointGenerator") {
+  constexpr Distribution allDistributions[] = {
+      Distribution::UniformSquare,    Distribution::UniformDisk,
+      Distribution::OnCircle,         Distribution::GaussianClusters,
+      Distribution::NearlyCollinear,  Distribution::JitteredGrid,
+      Distribution::HullAdversarial,  Distribution::HugeCoordinates};
+
+  TEST_CASE("Reproducible") {
+    for (Distribution distribution : allDistributions) {
+      auto a = generatePoints<int64_t>(distribution, 1000, 42);
+      CHECK(a == generatePoints<int64_t>(distribution, 1000, 42));
+      CHECK(a != generatePoints<int64_t>(distribution, 1000, 43));
+      CHECK(a.size() == 1000);
+    }
+    // Fixed values: a change here changes every benchmark input.
+    auto golden = generatePoints<int64_t>(Distribution::UniformSquare, 2, 1);
+    CHECK(golden[0] == LPoint(-767816, -762510));
+    CHECK(golden[1] == LPoint(-102310, -1004485));
+  }
+
+  TEST_CASE("Shapes") {
+    const double r = 1 << 20;
+    for (LPoint P : generatePoints<int64_t>(Distribution::UniformSquare,
+                                            1000)) {
+      CHECK(std::abs(P.x()) <= r);
+      CHECK(std::abs(P.y()) <= r);
+    }
+    for (auto P : generatePoints<double>(Distribution::UniformDisk, 1000))
+      CHECK(P.len2() <= r * r);
+    for (auto P : generatePoints<double>(Distribution::OnCircle, 1000))
+      CHECK(std::abs(std::sqrt(P.len2()) - r) < 1e-6);
+
+    auto line = generatePoints<int64_t>(Distribution::NearlyCollinear, 1000);
+    LVector direction = *std::max_element(
+        line.begin(), line.end(),
+        [](LPoint A, LPoint B) { return A.len2() < B.len2(); });
+    for (LPoint P : line)
+      CHECK(std::abs(double(direction % P)) /
+                std::sqrt(double(direction.len2())) <
+            3);
+
+    auto grid = generatePoints<int64_t>(Distribution::JitteredGrid, 100, 1,
+                                        100);
+    std::sort(grid.begin(), grid.end());
+    CHECK(std::unique(grid.begin(), grid.end()) == grid.end());
+
+    for (LPoint P : generatePoints<int64_t>(Distribution::HugeCoordinates,
+                                            100))
+      CHECK(std::abs(P.x()) <= (int64_t(1) << 62));
+    auto huge = generatePoints<int64_t>(Distribution::HugeCoordinates, 100);
+    CHECK(std::any_of(huge.begin(), huge.end(), [](LPoint P) {
+      return std::abs(P.x()) > (int64_t(1) << 61);
+    }));
+  }
+
+  TEST_CASE("Hull adversarial input is all hull") {
+    auto points = generatePoints<int64_t>(Distribution::HullAdversarial, 999);
+    acmlib::io::HullStage<int64_t> hull;
+    hull(points.data(), points.size());
+    CHECK(hull.hull().size() == points.size());
+    CHECK(!std::is_sorted(points.begin(), points.end()));
+  }
+
+  TEST_CASE("Hull stage on every distribution") {
+    for (Distribution distribution : allDistributions) {
+      if (distribution == Distribution::HugeCoordinates)
+        continue;
+      auto points = generatePoints<int64_t>(distribution, 5000, 7);
+      acmlib::io::HullStage<int64_t> chunked, whole;
+      for (size_t i = 0; i < points.size(); i += 333)
+        chunked(points.data() + i, std::min<size_t>(333, points.size() - i));
+      whole(points.data(), points.size());
+      CHECK(chunked.hull() == whole.hull());
+    }
+  }
+}
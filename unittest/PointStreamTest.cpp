@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "FastIO.hpp"
+#include "Geometry.hpp"
+#include "PointFile.hpp"
+#include "PointStream.hpp"
+#include "doctest.h"
+
+using namespace acmlib::geometry;
+using namespace acmlib::io;
+
+TEST_SUITE("IO::PointStream") {
+  std::vector<LPoint> randomPoints(size_t n, int64_t range) {
+    std::mt19937_64 rng(39);
+    std::vector<LPoint> points(n);
+    for (auto &P : points)
+      P = {int64_t(rng() % (2 * range + 1)) - range,
+           int64_t(rng() % (2 * range + 1)) - range};
+    return points;
+  }
+
+  std::string toText(const std::vector<LPoint> &points) {
+    std::string text;
+    for (LPoint P : points)
+      text += std::to_string(P.x()) + ' ' + std::to_string(P.y()) + '\n';
+    return text;
+  }
+
+  // Reference hull by gift wrapping on the distinct points,
+  // counterclockwise from the lowest of the leftmost points.
+  std::vector<LPoint> referenceHull(std::vector<LPoint> points) {
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    if (points.size() < 3)
+      return points;
+    std::vector<LPoint> hull;
+    LPoint current = points[0];
+    do {
+      hull.push_back(current);
+      LPoint next = points[0] == current ? points[1] : points[0];
+      for (LPoint P : points) {
+        int64_t turn = (next - current) % (P - current);
+        if (turn < 0 || (turn == 0 && dist2(current, P) > dist2(current, next)))
+          next = P;
+      }
+      current = next;
+    } while (current != hull[0]);
+    return hull;
+  }
+
+  TEST_CASE("Chunks cover the input in order") {
+    std::vector<LPoint> expected = randomPoints(1000, 1000);
+    std::string text = toText(expected);
+    for (size_t chunk : {1, 7, 1000, 4096}) {
+      Reader in(text.data(), text.size());
+      std::vector<LPoint> seen;
+      size_t largest = 0;
+      uint64_t total = streamPoints<int64_t>(
+          ReaderSource<int64_t>(in),
+          [&](const LPoint *points, size_t n) {
+            seen.insert(seen.end(), points, points + n);
+            largest = std::max(largest, n);
+          },
+          chunk);
+      CHECK(total == expected.size());
+      CHECK(seen == expected);
+      CHECK(largest == std::min(chunk, expected.size()));
+    }
+  }
+
+  TEST_CASE("Reader source stops after the given count") {
+    std::string text = "1 2 3 4 5 6 7 8";
+    Reader in(text.data(), text.size());
+    std::vector<LPoint> seen;
+    streamPoints<int64_t>(
+        ReaderSource<int64_t>(in, 3),
+        [&](const LPoint *points, size_t n) {
+          seen.insert(seen.end(), points, points + n);
+        },
+        2);
+    CHECK(seen == std::vector<LPoint>{{1, 2}, {3, 4}, {5, 6}});
+    int64_t rest;
+    CHECK(bool(in >> rest));
+    CHECK(rest == 7);
+  }
+
+  TEST_CASE("Exceptions reach the caller") {
+    std::string text = toText(randomPoints(100, 10));
+    Reader in(text.data(), text.size());
+    size_t calls = 0;
+    auto failingSource = [&](LPoint *buffer, size_t capacity) {
+      if (++calls == 3)
+        throw std::runtime_error("read error");
+      return ReaderSource<int64_t>(in, capacity)(buffer, capacity);
+    };
+    CHECK_THROWS_AS(streamPoints<int64_t>(
+                        failingSource, [](const LPoint *, size_t) {}, 10),
+                    std::runtime_error);
+
+    Reader again(text.data(), text.size());
+    CHECK_THROWS_AS(streamPoints<int64_t>(
+                        ReaderSource<int64_t>(again),
+                        [](const LPoint *, size_t) {
+                          throw std::logic_error("bad chunk");
+                        },
+                        10),
+                    std::logic_error);
+  }
+
+  TEST_CASE("Stages match whole-input results") {
+    std::vector<LPoint> points = randomPoints(20000, 1000000);
+    std::string text = toText(points);
+
+    Reader in(text.data(), text.size());
+    BoundingBoxStage<int64_t> box;
+    HullStage<int64_t> hull;
+    streamPoints<int64_t>(ReaderSource<int64_t>(in), stages(box, hull), 999);
+
+    LPoint lo, hi;
+    boundingBox(points.data(), points.size(), lo, hi);
+    CHECK(box.count() == points.size());
+    CHECK(box.lo() == lo);
+    CHECK(box.hi() == hi);
+    CHECK(hull.hull() == referenceHull(points));
+    CHECK(hull.prefilterSurvivors() < points.size() / 10);
+
+    GridBucketStage<int64_t> grid(box.lo(), box.hi(), 16, 8);
+    Reader second(text.data(), text.size());
+    streamPoints<int64_t>(ReaderSource<int64_t>(second), stages(grid), 999);
+    std::vector<uint64_t> expected(16 * 8);
+    for (LPoint P : points) {
+      size_t column = (P.x() - lo.x()) * 16 / (hi.x() - lo.x() + 1);
+      size_t row = (P.y() - lo.y()) * 8 / (hi.y() - lo.y() + 1);
+      ++expected[row * 16 + column];
+    }
+    CHECK(grid.counts() == expected);
+  }
+
+  TEST_CASE("Hull of degenerate inputs") {
+    auto hullOf = [](std::vector<LPoint> points) {
+      HullStage<int64_t> hull;
+      for (size_t i = 0; i < points.size(); i += 2)
+        hull(points.data() + i, std::min<size_t>(2, points.size() - i));
+      return hull.hull();
+    };
+    CHECK(hullOf({}).empty());
+    CHECK(hullOf({{1, 1}, {1, 1}, {1, 1}}) == std::vector<LPoint>{{1, 1}});
+    CHECK(hullOf({{0, 0}, {2, 2}, {1, 1}, {3, 3}}) ==
+          std::vector<LPoint>{{0, 0}, {3, 3}});
+    CHECK(hullOf({{0, 0}, {2, 0}, {2, 2}, {0, 2}, {1, 1}, {1, 0}, {0, 1}}) ==
+          std::vector<LPoint>{{0, 0}, {2, 0}, {2, 2}, {0, 2}});
+  }
+
+  TEST_CASE("Point file source") {
+    char name[] = "/tmp/acmlib-pointstream-XXXXXX";
+    close(mkstemp(name));
+    std::vector<LPoint> expected = randomPoints(5000, 1 << 20);
+    for (Layout layout : {Layout::Interleaved, Layout::Columns}) {
+      writePointFile(name, expected.data(), expected.size(), layout);
+      PointFile file(name);
+      std::vector<LPoint> seen;
+      streamPoints<int64_t>(
+          PointFileSource<int64_t>(file),
+          [&](const LPoint *points, size_t n) {
+            seen.insert(seen.end(), points, points + n);
+          },
+          1234);
+      CHECK(seen == expected);
+    }
+    std::remove(name);
+  }
+
+  TEST_CASE("Real coordinates") {
+    std::string text = "0 0  4 0  4 4  0 4  2 2  1 3  3.5 0.5";
+    Reader in(text.data(), text.size());
+    BoundingBoxStage<Real> box;
+    HullStage<Real> hull;
+    streamPoints<Real>(ReaderSource<Real>(in), stages(box, hull), 3);
+    CHECK(box.lo() == RPoint(0, 0));
+    CHECK(box.hi() == RPoint(4, 4));
+    std::vector<RPoint> square{RPoint(0, 0), RPoint(4, 0), RPoint(4, 4),
+                               RPoint(0, 4)};
+    CHECK(bool(hull.hull() == square));
+    GridBucketStage<Real> grid(box.lo(), box.hi(), 2, 2);
+    CHECK(grid.cell(RPoint(3.5, 0.5)) == 1);
+    CHECK(grid.cell(RPoint(1, 3)) == 2);
+    CHECK(grid.cell(RPoint(-1, 9)) == 2);
+  }
+}
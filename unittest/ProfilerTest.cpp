@@ -0,0 +1,118 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "Parallel.hpp"
+#include "Profiler.hpp"
+#include "doctest.h"
+
+using namespace acmlib::profiling;
+
+TEST_SUITE("Profiler") {
+  TEST_CASE("Scopes and counters") {
+    for (int i = 0; i < 100; ++i) {
+      PROFILE_SCOPE("test/outer");
+      PROFILE_COUNT("test/counter", 2);
+      for (int j = 0; j < 10; ++j) {
+        PROFILE_SCOPE("test/inner");
+      }
+    }
+    ThreadProfile::local().flush();
+    auto totals = Registry::global().snapshot();
+    CHECK(totals["test/outer"].calls == 100);
+    CHECK(totals["test/inner"].calls == 1000);
+    CHECK(totals["test/outer"].ticks >= totals["test/inner"].ticks);
+    CHECK(totals["test/counter"].calls == 0);
+    CHECK(totals["test/counter"].count == 200);
+
+    // Flushing again adds nothing.
+    ThreadProfile::local().flush();
+    CHECK(Registry::global().snapshot()["test/outer"].calls == 100);
+  }
+
+  TEST_CASE("Threads are merged at exit") {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+      threads.emplace_back([] {
+        for (int i = 0; i < 250; ++i) {
+          PROFILE_SCOPE("test/thread");
+          PROFILE_COUNT("test/thread counter", 1);
+        }
+      });
+    for (auto &thread : threads)
+      thread.join();
+    auto totals = Registry::global().snapshot();
+    CHECK(totals["test/thread"].calls == 1000);
+    CHECK(totals["test/thread counter"].count == 1000);
+  }
+
+  TEST_CASE("Work on a thread pool") {
+    {
+      acmlib::parallel::ThreadPool pool(4);
+      acmlib::parallel::TaskGroup group(pool);
+      for (int i = 0; i < 100; ++i)
+        group.run([] { PROFILE_SCOPE("test/pool"); });
+      group.wait();
+    }
+    ThreadProfile::local().flush();
+    CHECK(Registry::global().snapshot()["test/pool"].calls == 100);
+  }
+
+  TEST_CASE("Pools outliving the first scope are reported at exit") {
+    // Run in a fresh process of this binary, where nothing
+    // else touched the profiler or the global pool before.
+    if (std::getenv("ACMLIB_PROFILER_EXIT_TEST")) {
+      reportAtExit();
+      // A static pool created before the first use of the
+      // profiler, as ThreadPool::global() in a solution,
+      // with the tasks run by its workers only.
+      static acmlib::parallel::ThreadPool pool(4);
+      static std::atomic<int> done{0};
+      for (int i = 0; i < 100; ++i)
+        pool.submit([] {
+          PROFILE_SCOPE("test/exit pool");
+          done.fetch_add(1);
+        });
+      while (done.load() < 100)
+        std::this_thread::yield();
+      return;
+    }
+    char self[4096] = {};
+    REQUIRE(readlink("/proc/self/exe", self, sizeof(self) - 1) > 0);
+    std::string command = std::string("ACMLIB_PROFILER_EXIT_TEST=1 '") +
+                          self + "' -tc='Pools outliving*' 2>&1 >/dev/null";
+    std::FILE *child = popen(command.c_str(), "r");
+    REQUIRE(child);
+    std::string report;
+    char buffer[4096];
+    for (size_t k; (k = std::fread(buffer, 1, sizeof(buffer), child)) > 0;)
+      report.append(buffer, k);
+    CHECK(pclose(child) == 0);
+    size_t line = report.find("test/exit pool");
+    REQUIRE(line != std::string::npos);
+    unsigned long long calls = 0;
+    std::sscanf(report.c_str() + line + 14, "%llu", &calls);
+    CHECK(calls == 100);
+  }
+
+  TEST_CASE("Report") {
+    {
+      PROFILE_SCOPE("test/report");
+    }
+    ThreadProfile::local().flush();
+    char buffer[4096] = {};
+    std::FILE *file = fmemopen(buffer, sizeof(buffer) - 1, "w");
+    REQUIRE(file);
+    Registry::global().report(file);
+    std::fclose(file);
+    std::string report = buffer;
+    CHECK(report.find("test/report") != std::string::npos);
+    CHECK(report.find("test/counter") != std::string::npos);
+    CHECK(report.find("test/report") < report.find("counter"));
+    CHECK(Registry::global().secondsPerTick() > 0);
+  }
+}
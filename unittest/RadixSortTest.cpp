@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "RadixSort.hpp"
+#include "doctest.h"
+
+using namespace acmlib::algorithm;
+
+TEST_SUITE("Algorithm::RadixSort") {
+  TEST_CASE("Small inputs") {
+    std::vector<uint64_t> empty;
+    radixSortByKey(empty, [](uint64_t x) { return x; });
+    CHECK(empty.empty());
+    std::vector<uint64_t> single{42};
+    radixSortByKey(single, [](uint64_t x) { return x; });
+    CHECK(single == std::vector<uint64_t>{42});
+    std::vector<uint64_t> values{5, 1ull << 63, 0, 300, 5, ~0ull, 256};
+    radixSortByKey(values, [](uint64_t x) { return x; });
+    CHECK(values ==
+          std::vector<uint64_t>{0, 5, 5, 256, 300, 1ull << 63, ~0ull});
+  }
+
+  TEST_CASE("Stability") {
+    std::vector<std::pair<int, std::string>> values{
+        {2, "a"}, {1, "b"}, {2, "c"}, {0, "d"}, {1, "e"}};
+    radixSortByKey(values, [](const auto &p) { return p.first; });
+    std::string order;
+    for (const auto &p : values)
+      order += p.second;
+    CHECK(order == "dbeac");
+  }
+
+  TEST_CASE("Matches std::stable_sort") {
+    std::mt19937_64 rng(33);
+    for (size_t threads : {1, 3, 0}) {
+      std::vector<std::pair<uint64_t, size_t>> values(100000);
+      for (size_t i = 0; i < values.size(); ++i)
+        values[i] = {rng() >> (rng() % 64), i};
+      auto expected = values;
+      std::stable_sort(
+          expected.begin(), expected.end(),
+          [](const auto &a, const auto &b) { return a.first < b.first; });
+      radixSortByKey(
+          values, [](const auto &p) { return p.first; }, threads);
+      CHECK(values == expected);
+    }
+  }
+}
@@ -0,0 +1,124 @@
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Geometry.hpp"
+#include "Rational.hpp"
+#include "doctest.h"
+
+using namespace acmlib::geometry;
+using namespace acmlib::numeric;
+
+TEST_SUITE("Numeric::Rational") {
+  constexpr int64_t maxInt64 = std::numeric_limits<int64_t>::max();
+
+  TEST_CASE("Construction") {
+    LRational zero;
+    CHECK(zero.numerator() == 0);
+    CHECK(zero.denominator() == 1);
+    LRational integer = -7;
+    CHECK(integer.numerator() == -7);
+    CHECK(integer.denominator() == 1);
+    LRational fraction(6, -4);
+    CHECK(fraction.numerator() == -3);
+    CHECK(fraction.denominator() == 2);
+    XRational wide(LRational(10, 4));
+    CHECK(wide == XRational(5, 2));
+    CHECK((double)LRational(1, 4) == 0.25);
+  }
+
+  TEST_CASE("Arithmetic") {
+    CHECK(LRational(1, 2) + LRational(1, 3) == LRational(5, 6));
+    CHECK(LRational(1, 2) - LRational(1, 3) == LRational(1, 6));
+    CHECK(LRational(2, 3) * LRational(9, 4) == LRational(3, 2));
+    CHECK(LRational(2, 3) / LRational(4, 9) == LRational(3, 2));
+    CHECK(LRational(1, 3) + 1 == LRational(4, 3));
+    CHECK(2 * LRational(1, 4) == LRational(1, 2));
+    CHECK(-LRational(1, 5) == LRational(-1, 5));
+    CHECK(LRational(3, 7).inverse() == LRational(7, 3));
+    LRational sum;
+    for (int64_t i = 1; i <= 40; ++i)
+      sum += LRational(1, i * (i + 1));
+    CHECK(sum == LRational(40, 41));
+  }
+
+  TEST_CASE("Overflow fallback to reduction") {
+    LRational big(maxInt64 - 1, 2);
+    CHECK(big * LRational(2, maxInt64 - 1) == 1);
+    LRational unreduced(1, 1);
+    for (int i = 0; i < 200; ++i)
+      unreduced = unreduced * LRational(3, 3);
+    CHECK(unreduced == 1);
+    LRational a(1, maxInt64 / 2), b(1, maxInt64 / 3);
+    CHECK(a - b + b == a);
+    CHECK_THROWS_AS(LRational(maxInt64) * 2, std::overflow_error);
+    CHECK_THROWS_AS(LRational(maxInt64) + 1, std::overflow_error);
+  }
+
+  TEST_CASE("Comparison") {
+    CHECK(LRational(1, 3) < LRational(1, 2));
+    CHECK(LRational(-1, 2) < LRational(-1, 3));
+    CHECK(LRational(2, 4) == LRational(1, 2));
+    CHECK(LRational(2, 4) <= LRational(1, 2));
+    CHECK(LRational(5, 3) > 1);
+    CHECK(LRational(0) == 0);
+    CHECK(LRational(1, 3) != LRational(333'333, 1'000'000));
+    // Cross products overflow int64_t here.
+    LRational p(maxInt64 - 1, maxInt64), q(maxInt64 - 2, maxInt64 - 1);
+    CHECK(q < p);
+    CHECK(p > q);
+    CHECK(-p < -q);
+    CHECK(p != q);
+    CHECK(LRational(maxInt64 - 1, maxInt64) ==
+          LRational(maxInt64 - 1, maxInt64));
+    CHECK(sign(LRational(-1, maxInt64)) == -1);
+  }
+
+  TEST_CASE("I/O stream operators") {
+    std::istringstream is("3/6 -4 10/-5");
+    std::vector<LRational> expected{{1, 2}, -4, -2};
+    for (auto value : expected) {
+      LRational x;
+      is >> x;
+      CHECK(x == value);
+    }
+    std::ostringstream os;
+    os << LRational(4, 6) << ' ' << LRational(-10, 5);
+    CHECK(os.str() == "2/3 -2");
+    std::istringstream wideInput("-170141183460469231731687303715884105727/3");
+    XRational wide;
+    wideInput >> wide;
+    std::ostringstream wideOutput;
+    wideOutput << wide;
+    CHECK(wideOutput.str() == "-170141183460469231731687303715884105727/3");
+  }
+
+  TEST_CASE("Exact geometry") {
+    using QLine = Line<XRational>;
+    using QPoint = Point<XRational>;
+    LLine l{LPoint(0, 0), LPoint(3, 1)};
+    LLine m{LPoint(0, 1), LPoint(1, 0)};
+    QPoint P = intersection(QLine(l), QLine(m));
+    CHECK(P == QPoint(XRational(3, 4), XRational(1, 4)));
+    CHECK(QLine(l).contains(P));
+    CHECK(QLine(m).contains(P));
+    QPoint H = projection(QLine(m), QPoint(0, 0));
+    CHECK(H == QPoint(XRational(1, 2), XRational(1, 2)));
+    CHECK(Vector<XRational>(H, QPoint(0, 0)).parallelTo({1, 1}));
+
+    // Far from the origin, long double loses the exact answer.
+    const int64_t big = 1'000'000'000'000;
+    LLine u{LPoint(-big, 1), LPoint(big, 2)};
+    LLine v{LPoint(1, -big), LPoint(3, big)};
+    QPoint Q = intersection(QLine(u), QLine(v));
+    CHECK(QLine(u).relativePosition(Q) == 0);
+    CHECK(QLine(v).relativePosition(Q) == 0);
+
+    Matrix<LRational> half{LRational(1, 2), 0, 0, LRational(1, 2)};
+    CHECK(half * Vector<LRational>(1, 3) ==
+          Vector<LRational>(LRational(1, 2), LRational(3, 2)));
+    CHECK(half.det() == LRational(1, 4));
+  }
+}
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "Geometry.hpp"
+#include "SpatialSort.hpp"
+#include "doctest.h"
+
+using namespace acmlib::geometry;
+
+TEST_SUITE("Geometry::SpatialSort") {
+  TEST_CASE("Curve indices") {
+    static_assert(mortonIndex(0, 0) == 0);
+    static_assert(mortonIndex(1, 0) == 1);
+    static_assert(mortonIndex(0, 1) == 2);
+    static_assert(mortonIndex(3, 3) == 15);
+    static_assert(mortonIndex(~0u, ~0u) == ~0ull);
+    static_assert(hilbertIndex(0, 0) == 0);
+    static_assert(hilbertIndex(~0u, 0) == ~0ull);
+
+    // The table-driven index agrees with the textbook
+    // bit-by-bit construction.
+    auto reference = [](uint32_t x, uint32_t y) {
+      uint64_t d = 0;
+      for (uint32_t s = 1u << 31; s > 0; s >>= 1) {
+        uint32_t rx = (x & s) != 0, ry = (y & s) != 0;
+        d += uint64_t(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+          if (rx == 1) {
+            x = ~x;
+            y = ~y;
+          }
+          std::swap(x, y);
+        }
+      }
+      return d;
+    };
+    std::mt19937 rng(33);
+    for (int i = 0; i < 1000; ++i) {
+      uint32_t x = rng(), y = rng();
+      CHECK(hilbertIndex(x, y) == reference(x, y));
+    }
+
+    // Consecutive Hilbert cells are adjacent.
+    const uint32_t top = ~0u;
+    std::vector<std::pair<uint64_t, LPoint>> cells;
+    for (uint32_t x = 0; x < 4; ++x)
+      for (uint32_t y = 0; y < 4; ++y) {
+        cells.push_back({hilbertIndex(x, y), LPoint(x, y)});
+        cells.push_back({hilbertIndex(top - x, y), LPoint(-1 - x, y)});
+      }
+    std::sort(cells.begin(), cells.end(), [](const auto &a, const auto &b) {
+      return a.first < b.first;
+    });
+    for (size_t i = 0; i + 1 < cells.size(); ++i)
+      if (cells[i + 1].first == cells[i].first + 1)
+        CHECK(dist2(cells[i].second, cells[i + 1].second) == 1);
+  }
+
+  TEST_CASE("Sorting is a permutation along the curve") {
+    std::mt19937_64 rng(33);
+    for (Curve curve : {Curve::Hilbert, Curve::Morton}) {
+      std::vector<LPoint> points(50000);
+      for (LPoint &P : points)
+        P = LPoint(int64_t(rng() % 2000001) - 1000000,
+                   int64_t(rng() % 2000001) - 1000000);
+      std::multiset<LPoint> before(points.begin(), points.end());
+      spatialSort(points, curve, 4);
+      CHECK(std::multiset<LPoint>(points.begin(), points.end()) == before);
+
+      // Hilbert and Z-order tours are much shorter than random ones.
+      long double length = 0;
+      for (size_t i = 0; i + 1 < points.size(); ++i)
+        length += (long double)dist(points[i], points[i + 1]);
+      CHECK(length < 0.1l * 1e6l * points.size());
+    }
+  }
+
+  TEST_CASE("Coordinate types") {
+    std::vector<RPoint> real{{0.5, 0.5}, {-3, 7}, {0.25, 0.5}, {-3, 6.5}};
+    spatialSort(real);
+    CHECK(real[0] == RPoint(0.25, 0.5));
+    CHECK(real[1] == RPoint(-3, 6.5));
+    CHECK(real[2] == RPoint(-3, 7));
+    CHECK(real[3] == RPoint(0.5, 0.5));
+
+    // Extreme integer coordinates must not overflow the grid.
+    const int64_t big = std::numeric_limits<int64_t>::max();
+    std::vector<LPoint> extreme{{big, 0}, {-big - 1, 0}, {0, big}, {0, 0}};
+    spatialSort(extreme, Curve::Morton);
+    CHECK(extreme[0] == LPoint(-big - 1, 0));
+    CHECK(extreme[3] == LPoint(0, big));
+
+    std::vector<LPoint> same(5, LPoint(4, 4));
+    spatialSort(same);
+    CHECK(same == std::vector<LPoint>(5, LPoint(4, 4)));
+  }
+
+  // Points of type T with coordinates in [-range, range].
+  template <typename T>
+  std::vector<Point<T>> randomPoints(size_t n, int64_t range, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int64_t> coordinate(-range, range);
+    std::vector<Point<T>> points(n);
+    for (auto &P : points)
+      P = Point<T>(coordinate(rng), coordinate(rng));
+    return points;
+  }
+
+  template <typename T>
+  void checkLexicographicSort(std::vector<Point<T>> points, size_t threads) {
+    auto expected = points;
+    std::stable_sort(expected.begin(), expected.end());
+    lexicographicSort(points, threads);
+    CHECK(points == expected);
+  }
+
+  TEST_CASE("Lexicographic sort") {
+    for (size_t threads : {1, 4}) {
+      checkLexicographicSort(randomPoints<int64_t>(50000, 1000, 1), threads);
+      checkLexicographicSort(randomPoints<int64_t>(50000, 1ll << 40, 2),
+                             threads);
+      checkLexicographicSort(
+          randomPoints<int64_t>(50000, std::numeric_limits<int64_t>::max(), 3),
+          threads);
+      checkLexicographicSort(randomPoints<int32_t>(50000, 1 << 30, 4), threads);
+      checkLexicographicSort(randomPoints<int16_t>(50000, 30000, 5), threads);
+      checkLexicographicSort(randomPoints<uint64_t>(1000, 1000, 6), threads);
+
+      auto reals = randomPoints<double>(50000, 100, 7);
+      for (size_t i = 0; i < reals.size(); ++i)
+        reals[i] = reals[i] * (i % 3 ? 1e-3 : 1e9);
+      checkLexicographicSort(reals, threads);
+    }
+
+    std::vector<Point<double>> zeros{{0.0, 1.0}, {-0.0, -1.0}, {-1e-300, 5},
+                                     {0.0, -1.0}, {-0.0, 0.0}};
+    lexicographicSort(zeros);
+    CHECK(zeros[0] == Point<double>(-1e-300, 5));
+    CHECK(zeros[1] == Point<double>(0.0, -1.0));
+    CHECK(zeros[2] == Point<double>(0.0, -1.0));
+    CHECK(zeros[3] == Point<double>(0.0, 0.0));
+    CHECK(zeros[4] == Point<double>(0.0, 1.0));
+
+    const int64_t big = std::numeric_limits<int64_t>::max();
+    std::vector<LPoint> extreme{
+        {0, big}, {0, -big - 1}, {big, 0}, {-big - 1, 0}};
+    lexicographicSort(extreme);
+    CHECK(extreme == std::vector<LPoint>{
+                         {-big - 1, 0}, {0, -big - 1}, {0, big}, {big, 0}});
+
+    std::vector<LPoint> none;
+    lexicographicSort(none);
+    CHECK(none.empty());
+  }
+}